@@ -0,0 +1,588 @@
+#include "graph.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <cmath>
+#include <thread>
+#include <sys/resource.h>
+
+using namespace std;
+
+/// -------- GRAPH BENCHMARK --------
+/* Builds Erdos-Renyi, R-MAT and grid graphs of a set size through the Graph
+API and times the main operations on them. Results are written as JSON:
+for every graph and operation the number of calls, the total time, the
+throughput (items per second, see each operation) and the latency
+percentiles of a single call, plus the peak RSS of the process after each
+graph. The same seed always gives the same graphs and queries.
+
+Usage: graph_bench [--size small|medium|large] [--seed N] [--repeat N]
+                   [--threads 1,2,4,...] [--output file.json]
+                   [--file scratch.txt]
+
+The parallel breadth-first search runs once per thread count, by default
+the powers of two up to the hardware threads.
+*/
+
+namespace {
+    typedef chrono::steady_clock Clock;
+
+    struct Options {
+        string size = "small";
+        uint64_t seed = 1;
+        int repeat = 3;
+        vector<unsigned> threads;
+        string output;
+        string file = "graph_bench.tmp";
+    };
+
+    struct EdgeList {
+        string name;
+        bool isDirected;
+        VertexId numVertices;
+        vector<pair<VertexId, VertexId>> edges;
+    };
+
+    /* Calls timed one by one, items is what the throughput counts
+    (edges, visited vertices...), which may differ from the calls. Threads
+    is only set on operations swept over thread counts. */
+    struct Operation {
+        string name;
+        uint64_t items;
+        vector<double> latencies;
+        unsigned threads = 0;
+    };
+
+    class Stopwatch {
+    private:
+        Clock::time_point start;
+
+    public:
+        Stopwatch() : start(Clock::now()) {}
+
+        double nanoseconds() const {
+            return chrono::duration<double, nano>(Clock::now() - start).count();
+        }
+    };
+
+    /// --- GENERATORS ---
+    /* Edges are drawn until there are numEdges different ones. Each round
+    draws only as many edges as are still missing, so the deduplicated list
+    never grows past numEdges and no edge has to be dropped. Self loops are
+    skipped so every generator gives simple graphs. */
+    EdgeList erdosRenyi(const VertexId& numVertices, const uint64_t& numEdges, mt19937_64& rng) {
+        EdgeList result{"erdos_renyi", true, numVertices, {}};
+        uniform_int_distribution<VertexId> vertex(0, numVertices - 1);
+        vector<uint64_t> seen;
+
+        seen.reserve(numEdges * 2);
+        while(seen.size() < numEdges){
+            uint64_t missing(numEdges - seen.size());
+            for(uint64_t i(0); i < missing; i++){
+                VertexId origin(vertex(rng)), destination(vertex(rng));
+                if(origin != destination){
+                    seen.push_back(uint64_t(origin) << 32 | destination);
+                }
+            }
+            sort(seen.begin(), seen.end());
+            seen.erase(unique(seen.begin(), seen.end()), seen.end());
+        }
+
+        result.edges.reserve(numEdges);
+        for(vector<uint64_t>::const_iterator it(seen.begin()); it != seen.end(); it++){
+            result.edges.push_back(make_pair(VertexId(*it >> 32), VertexId(*it)));
+        }
+
+        shuffle(result.edges.begin(), result.edges.end(), rng);
+        return result;
+    }
+
+    /* Recursive matrix generator with the usual (0.57, 0.19, 0.19, 0.05)
+    quadrant probabilities, which gives a power-law degree distribution.
+    Vertex ids are permuted so the hubs aren't all at the start. */
+    EdgeList rmat(const unsigned& scale, const uint64_t& numEdges, mt19937_64& rng) {
+        const VertexId numVertices(VertexId(1) << scale);
+        EdgeList result{"rmat", true, numVertices, {}};
+        uniform_real_distribution<double> quadrant(0.0, 1.0);
+        vector<VertexId> permutation(numVertices);
+        vector<uint64_t> seen;
+
+        for(VertexId i(0); i < numVertices; i++){
+            permutation[i] = i;
+        }
+        shuffle(permutation.begin(), permutation.end(), rng);
+
+        seen.reserve(numEdges * 2);
+        while(seen.size() < numEdges){
+            uint64_t missing(numEdges - seen.size());
+            for(uint64_t i(0); i < missing; i++){
+                VertexId origin(0), destination(0);
+                for(unsigned bit(0); bit < scale; bit++){
+                    double p(quadrant(rng));
+                    origin = origin << 1 | (p >= 0.76 ? 1 : 0);
+                    destination = destination << 1 | ((p >= 0.57 && p < 0.76) || p >= 0.95 ? 1 : 0);
+                }
+                if(origin != destination){
+                    seen.push_back(uint64_t(permutation[origin]) << 32 | permutation[destination]);
+                }
+            }
+            sort(seen.begin(), seen.end());
+            seen.erase(unique(seen.begin(), seen.end()), seen.end());
+        }
+
+        result.edges.reserve(numEdges);
+        for(vector<uint64_t>::const_iterator it(seen.begin()); it != seen.end(); it++){
+            result.edges.push_back(make_pair(VertexId(*it >> 32), VertexId(*it)));
+        }
+        shuffle(result.edges.begin(), result.edges.end(), rng);
+        return result;
+    }
+
+    /* Undirected side x side grid, every vertex linked to its right and
+    lower neighbours. */
+    EdgeList grid(const VertexId& side) {
+        EdgeList result{"grid", false, side * side, {}};
+
+        for(VertexId row(0); row < side; row++){
+            for(VertexId column(0); column < side; column++){
+                VertexId v(row * side + column);
+                if(column + 1 < side){
+                    result.edges.push_back(make_pair(v, v + 1));
+                }
+                if(row + 1 < side){
+                    result.edges.push_back(make_pair(v, v + side));
+                }
+            }
+        }
+        return result;
+    }
+
+    /// --- BENCHMARKS ---
+    string label(const VertexId& v) {
+        return to_string(v);
+    }
+
+    vector<VertexId> randomVertices(const size_t& count, const VertexId& numVertices, mt19937_64& rng) {
+        uniform_int_distribution<VertexId> vertex(0, numVertices - 1);
+        vector<VertexId> result(count);
+        for(size_t i(0); i < count; i++){
+            result[i] = vertex(rng);
+        }
+        return result;
+    }
+
+    void buildGraph(Graph& g, const EdgeList& list, const vector<int>& weights, vector<Operation>& operations) {
+        Operation vertices{"insert_vertex", list.numVertices, {}};
+        Operation edges{"insert_edge", list.edges.size(), {}};
+        vector<string> labels(list.numVertices);
+
+        g.setIsDirected(list.isDirected);
+        for(VertexId i(0); i < list.numVertices; i++){
+            labels[i] = label(i);
+        }
+
+        vertices.latencies.reserve(list.numVertices);
+        for(VertexId i(0); i < list.numVertices; i++){
+            Stopwatch watch;
+            g.insertVertex(labels[i]);
+            vertices.latencies.push_back(watch.nanoseconds());
+        }
+
+        edges.latencies.reserve(list.edges.size());
+        for(size_t i(0); i < list.edges.size(); i++){
+            Stopwatch watch;
+            g.insertEdge(labels[list.edges[i].first], labels[list.edges[i].second], weights[i]);
+            edges.latencies.push_back(watch.nanoseconds());
+        }
+
+        operations.push_back(vertices);
+        operations.push_back(edges);
+    }
+
+    void benchFiles(Graph& g, const Options& options, vector<Operation>& operations) {
+        uint64_t numEdges(0);
+        for(VertexId i(0); i < VertexId(g.getNumVertices()); i++){
+            numEdges += g.findVertex(i)->getDegree();
+        }
+
+        Operation save{"save_to_file", 0, {}};
+        Operation load{"get_from_file", 0, {}};
+        for(int r(0); r < options.repeat; r++){
+            Stopwatch saveWatch;
+            g.saveToFile(options.file);
+            save.latencies.push_back(saveWatch.nanoseconds());
+            save.items += numEdges;
+
+            Graph loaded;
+            Stopwatch loadWatch;
+            if(!loaded.getFromFile(options.file)){
+                throw GraphException("graph_bench: can't read " + options.file);
+            }
+            load.latencies.push_back(loadWatch.nanoseconds());
+            load.items += numEdges;
+        }
+        remove(options.file.c_str());
+
+        operations.push_back(save);
+        operations.push_back(load);
+    }
+
+    /* Traverses count the vertices they reach, routes count one per query. */
+    void benchTraversals(Graph& g, const Options& options, mt19937_64& rng, vector<Operation>& operations) {
+        const VertexId numVertices(g.getNumVertices());
+        vector<VertexId> origins(randomVertices(options.repeat * 4, numVertices, rng));
+        vector<VertexId> ends(randomVertices(256, numVertices, rng));
+        vector<VertexId> starts(randomVertices(256, numVertices, rng));
+
+        Operation bfs{"bfs_traverse", 0, {}};
+        Operation dfs{"dfs_traverse", 0, {}};
+        for(vector<VertexId>::const_iterator it(origins.begin()); it != origins.end(); it++){
+            Stopwatch bfsWatch;
+            bfs.items += g.breadthFirstTraverse(*it).size();
+            bfs.latencies.push_back(bfsWatch.nanoseconds());
+
+            Stopwatch dfsWatch;
+            dfs.items += g.depthFirstTraverse(*it).size();
+            dfs.latencies.push_back(dfsWatch.nanoseconds());
+        }
+
+        Operation bfsRoute{"bfs_route", 0, {}};
+        Operation dfsRoute{"dfs_route", 0, {}};
+        for(size_t i(0); i < starts.size(); i++){
+            Stopwatch bfsWatch;
+            g.breadthFirstRoute(starts[i], ends[i]);
+            bfsRoute.latencies.push_back(bfsWatch.nanoseconds());
+            bfsRoute.items++;
+
+            Stopwatch dfsWatch;
+            g.depthFirstRoute(starts[i], ends[i]);
+            dfsRoute.latencies.push_back(dfsWatch.nanoseconds());
+            dfsRoute.items++;
+        }
+
+        /* Directed graphs search the destination side over the in-edges. */
+        Operation bidirectionalRoute{"bidirectional_route", 0, {}};
+        g.setTrackInEdges(true);
+        for(size_t i(0); i < starts.size(); i++){
+            Stopwatch watch;
+            g.bidirectionalRoute(starts[i], ends[i]);
+            bidirectionalRoute.latencies.push_back(watch.nanoseconds());
+            bidirectionalRoute.items++;
+        }
+        g.setTrackInEdges(false);
+
+        /* The same queries reusing one QueryContext, then as one batch. */
+        Operation contextRoute{"bfs_route_context", 0, {}};
+        QueryContext context;
+        vector<RouteQuery> queries;
+        for(size_t i(0); i < starts.size(); i++){
+            Stopwatch watch;
+            g.breadthFirstRoute(starts[i], ends[i], context);
+            contextRoute.latencies.push_back(watch.nanoseconds());
+            contextRoute.items++;
+            queries.push_back(RouteQuery{starts[i], ends[i]});
+        }
+
+        Operation batchRoute{"bfs_routes_batch", 0, {}};
+        for(int r(0); r < options.repeat; r++){
+            Stopwatch watch;
+            batchRoute.items += g.breadthFirstRoutes(queries).size();
+            batchRoute.latencies.push_back(watch.nanoseconds());
+        }
+
+        Operation prim{"prim_spanning_tree", 0, {}};
+        for(int r(0); r < options.repeat; r++){
+            Stopwatch watch;
+            prim.items += g.primSpanningTree(origins[r]).size();
+            prim.latencies.push_back(watch.nanoseconds());
+        }
+
+        /* Neighbourhoods count the vertices they return. The cached run
+        asks for the same few vertices again and again. */
+        Operation kHop{"k_hop_neighbourhood", 0, {}};
+        for(vector<VertexId>::const_iterator it(origins.begin()); it != origins.end(); it++){
+            Stopwatch watch;
+            kHop.items += g.kHopNeighbourhood(*it, 2).size();
+            kHop.latencies.push_back(watch.nanoseconds());
+        }
+
+        Operation kHopCached{"k_hop_cached", 0, {}};
+        g.setQueryCacheCapacity(256);
+        g.buildHopIndex(2, 16);
+        for(size_t i(0); i < starts.size(); i++){
+            Stopwatch watch;
+            kHopCached.items += g.kHopNeighbourhood(starts[i % 32], 2).size();
+            kHopCached.latencies.push_back(watch.nanoseconds());
+        }
+        g.buildHopIndex(2, 0);
+        g.setQueryCacheCapacity(0);
+
+        /* Components and orders count vertices. */
+        Operation scc{"strongly_connected_components", 0, {}};
+        Operation topological{"topological_order", 0, {}};
+        for(int r(0); r < options.repeat; r++){
+            Stopwatch sccWatch;
+            scc.items += g.stronglyConnectedComponents().size();
+            scc.latencies.push_back(sccWatch.nanoseconds());
+
+            Stopwatch topologicalWatch;
+            g.topologicalOrder();
+            topological.items += numVertices;
+            topological.latencies.push_back(topologicalWatch.nanoseconds());
+        }
+
+        operations.push_back(bfs);
+        operations.push_back(dfs);
+        operations.push_back(bfsRoute);
+        operations.push_back(dfsRoute);
+        operations.push_back(bidirectionalRoute);
+        operations.push_back(contextRoute);
+        operations.push_back(batchRoute);
+        operations.push_back(prim);
+        operations.push_back(kHop);
+        operations.push_back(kHopCached);
+        operations.push_back(scc);
+        operations.push_back(topological);
+    }
+
+    /* Runs CsrGraph::parallelBreadthFirstSearch on a frozen copy with the
+    in-edges built, from the same origins for every thread count, counting
+    the vertices reached. */
+    void benchParallel(Graph& g, const Options& options, mt19937_64& rng, vector<Operation>& operations) {
+        CsrGraph frozen(g.freeze());
+        frozen.buildInEdges();
+        vector<VertexId> origins(randomVertices(options.repeat * 4, frozen.getNumVertices(), rng));
+
+        for(vector<unsigned>::const_iterator t(options.threads.begin()); t != options.threads.end(); t++){
+            Operation parallelBfs{"parallel_bfs", 0, {}, *t};
+            for(vector<VertexId>::const_iterator it(origins.begin()); it != origins.end(); it++){
+                Stopwatch watch;
+                BreadthFirstLevels levels(frozen.parallelBreadthFirstSearch(*it, *t));
+                parallelBfs.latencies.push_back(watch.nanoseconds());
+                parallelBfs.items += frozen.getNumVertices() - count(levels.distance.begin(), levels.distance.end(), BreadthFirstLevels::unreachedDistance);
+            }
+            operations.push_back(parallelBfs);
+        }
+    }
+
+    /* Copies count edges. Churn works on a copy: every deleted vertex is
+    replaced by a new one with as many random out-edges, so the size of
+    the Graph stays the same. Only deleteVertex is timed. */
+    void benchChurn(Graph& g, const Options& options, mt19937_64& rng, vector<Operation>& operations) {
+        uint64_t numEdges(0);
+        for(VertexId i(0); i < VertexId(g.getNumVertices()); i++){
+            numEdges += g.findVertex(i)->getDegree();
+        }
+
+        Operation copy{"copy", 0, {}};
+        for(int r(0); r < options.repeat; r++){
+            Stopwatch watch;
+            Graph copied(g);
+            copy.latencies.push_back(watch.nanoseconds());
+            copy.items += numEdges;
+        }
+
+        Graph churned(g);
+        Operation churn{"delete_vertex", 0, {}};
+        size_t rounds(min<size_t>(200, churned.getNumVertices() / 10));
+        VertexId nextLabel(churned.getNumVertices());
+        for(size_t r(0); r < rounds; r++){
+            VertexId numVertices(churned.getNumVertices());
+            VertexId victim(randomVertices(1, numVertices, rng)[0]);
+            string victimLabel(churned.getVertexLabel(victim));
+            int degree(churned.findVertex(victim)->getDegree());
+
+            Stopwatch watch;
+            churned.deleteVertex(victimLabel);
+            churn.latencies.push_back(watch.nanoseconds());
+            churn.items++;
+
+            string newLabel(label(nextLabel++));
+            churned.insertVertex(newLabel);
+            vector<VertexId> targets(randomVertices(degree, numVertices - 1, rng));
+            for(vector<VertexId>::const_iterator it(targets.begin()); it != targets.end(); it++){
+                churned.insertEdge(newLabel, churned.getVertexLabel(*it), 1);
+            }
+        }
+
+        operations.push_back(copy);
+        operations.push_back(churn);
+    }
+
+    /// --- REPORT ---
+    long peakRssKilobytes() {
+        rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        return usage.ru_maxrss;
+    }
+
+    /* Nearest rank percentile of sorted latencies. */
+    double percentile(const vector<double>& sorted, const double& p) {
+        if(sorted.empty()){
+            return 0;
+        }
+        size_t rank(size_t(ceil(p / 100.0 * sorted.size())));
+        return sorted[rank == 0 ? 0 : min(rank, sorted.size()) - 1];
+    }
+
+    void writeOperation(ostream& out, Operation& op) {
+        sort(op.latencies.begin(), op.latencies.end());
+        double totalNs(0);
+        for(vector<double>::const_iterator it(op.latencies.begin()); it != op.latencies.end(); it++){
+            totalNs += *it;
+        }
+        double seconds(totalNs / 1e9);
+
+        out << "        {\"name\": \"" << op.name << "\", ";
+        if(op.threads > 0){
+            out << "\"threads\": " << op.threads << ", ";
+        }
+        out << "\"calls\": " << op.latencies.size()
+            << ", \"items\": " << op.items << ", \"seconds\": " << seconds
+            << ", \"items_per_second\": " << (seconds > 0 ? op.items / seconds : 0)
+            << ", \"latency_ns\": {\"p50\": " << percentile(op.latencies, 50)
+            << ", \"p90\": " << percentile(op.latencies, 90)
+            << ", \"p99\": " << percentile(op.latencies, 99)
+            << ", \"max\": " << (op.latencies.empty() ? 0 : op.latencies.back()) << "}}";
+    }
+
+    void writeGraph(ostream& out, const EdgeList& list, vector<Operation>& operations, const long& peakRss) {
+        out << "    {\"graph\": \"" << list.name << "\", \"vertices\": " << list.numVertices
+            << ", \"edges\": " << list.edges.size() << ", \"directed\": " << (list.isDirected ? "true" : "false")
+            << ", \"peak_rss_kb\": " << peakRss << ",\n      \"operations\": [\n";
+        for(size_t i(0); i < operations.size(); i++){
+            writeOperation(out, operations[i]);
+            out << (i + 1 < operations.size() ? ",\n" : "\n");
+        }
+        out << "      ]}";
+    }
+
+    Options parseOptions(int argc, char** argv) {
+        Options options;
+
+        for(int i(1); i < argc; i++){
+            string arg(argv[i]);
+            if(i + 1 >= argc){
+                throw GraphException("graph_bench: missing value for " + arg);
+            }
+            string value(argv[++i]);
+
+            if(arg == "--size"){
+                options.size = value;
+            }
+            else if(arg == "--seed"){
+                options.seed = strtoull(value.c_str(), nullptr, 10);
+            }
+            else if(arg == "--repeat"){
+                options.repeat = max(1, atoi(value.c_str()));
+            }
+            else if(arg == "--threads"){
+                istringstream list(value);
+                string item;
+                while(getline(list, item, ',')){
+                    int n(atoi(item.c_str()));
+                    if(n <= 0){
+                        throw GraphException("graph_bench: thread counts must be positive.");
+                    }
+                    options.threads.push_back(n);
+                }
+            }
+            else if(arg == "--output"){
+                options.output = value;
+            }
+            else if(arg == "--file"){
+                options.file = value;
+            }
+            else{
+                throw GraphException("graph_bench: unknown option " + arg);
+            }
+        }
+
+        if(options.size != "small" && options.size != "medium" && options.size != "large"){
+            throw GraphException("graph_bench: size must be small, medium or large.");
+        }
+        if(options.threads.empty()){
+            unsigned hardware(max(1u, thread::hardware_concurrency()));
+            for(unsigned n(1); n <= hardware; n *= 2){
+                options.threads.push_back(n);
+            }
+        }
+        return options;
+    }
+}
+
+int main(int argc, char** argv) {
+    try{
+        Options options(parseOptions(argc, argv));
+
+        /* Every size has about 10 edges per vertex on the random graphs. */
+        VertexId erVertices(10000), gridSide(100);
+        unsigned rmatScale(13);
+        if(options.size == "medium"){
+            erVertices = 100000;
+            gridSide = 316;
+            rmatScale = 17;
+        }
+        else if(options.size == "large"){
+            erVertices = 1000000;
+            gridSide = 1000;
+            rmatScale = 20;
+        }
+
+        mt19937_64 rng(options.seed);
+        vector<EdgeList> lists;
+        lists.push_back(erdosRenyi(erVertices, uint64_t(erVertices) * 10, rng));
+        lists.push_back(rmat(rmatScale, (uint64_t(1) << rmatScale) * 10, rng));
+        lists.push_back(grid(gridSide));
+
+        ostringstream report;
+        report.precision(6);
+        report << "{\n  \"benchmark\": \"graph_bench\", \"size\": \"" << options.size << "\", \"seed\": " << options.seed
+               << ", \"repeat\": " << options.repeat << ",\n  \"graphs\": [\n";
+
+        for(size_t i(0); i < lists.size(); i++){
+            uniform_int_distribution<int> weight(1, 100);
+            vector<int> weights(lists[i].edges.size());
+            for(vector<int>::iterator it(weights.begin()); it != weights.end(); it++){
+                *it = weight(rng);
+            }
+
+            vector<Operation> operations;
+            {
+                Graph g;
+                buildGraph(g, lists[i], weights, operations);
+                benchFiles(g, options, operations);
+                benchTraversals(g, options, rng, operations);
+                benchParallel(g, options, rng, operations);
+                benchChurn(g, options, rng, operations);
+            }
+
+            writeGraph(report, lists[i], operations, peakRssKilobytes());
+            report << (i + 1 < lists.size() ? ",\n" : "\n");
+            cerr << lists[i].name << " done\n";
+        }
+        report << "  ]\n}\n";
+
+        if(options.output.empty()){
+            cout << report.str();
+        }
+        else{
+            ofstream file(options.output, ios::trunc);
+            file << report.str();
+        }
+    }
+    catch(const GraphException& e){
+        cerr << e.what() << '\n';
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,76 @@
+#include "concurrentgraph.h"
+
+using namespace std;
+
+/// --- PRIVATE METHODS ---
+void ConcurrentGraph::publishLocked() {
+    shared_ptr<const CsrGraph> next(make_shared<const CsrGraph>(graph.freeze()));
+    atomic_store(&current, next);
+    dirty = false;
+}
+
+/// --- PUBLIC METHODS ---
+ConcurrentGraph::ConcurrentGraph() : dirty(false) {
+    publishLocked();
+}
+
+ConcurrentGraph::ConcurrentGraph(const Graph& g) : graph(g), dirty(false) {
+    publishLocked();
+}
+
+shared_ptr<const CsrGraph> ConcurrentGraph::snapshot() {
+    if(dirty && writerMutex.try_lock()){
+        lock_guard<mutex> lock(writerMutex, adopt_lock);
+        if(dirty){
+            publishLocked();
+        }
+    }
+    return atomic_load(&current);
+}
+
+void ConcurrentGraph::insertVertex(const string& vertex) {
+    lock_guard<mutex> lock(writerMutex);
+    graph.insertVertex(vertex);
+    dirty = true;
+}
+
+void ConcurrentGraph::deleteVertex(const string& vertex) {
+    lock_guard<mutex> lock(writerMutex);
+    graph.deleteVertex(vertex);
+    dirty = true;
+}
+
+void ConcurrentGraph::editVertex(const string& oldVertex, const string& newVertex) {
+    lock_guard<mutex> lock(writerMutex);
+    graph.editVertex(oldVertex, newVertex);
+    dirty = true;
+}
+
+void ConcurrentGraph::insertEdge(const string& origin, const string& destination, const int& weight) {
+    lock_guard<mutex> lock(writerMutex);
+    graph.insertEdge(origin, destination, weight);
+    dirty = true;
+}
+
+void ConcurrentGraph::deleteEdge(const string& origin, const string& destination) {
+    lock_guard<mutex> lock(writerMutex);
+    graph.deleteEdge(origin, destination);
+    dirty = true;
+}
+
+void ConcurrentGraph::editEdge(const string& origin, const string& destination, const int& weight) {
+    lock_guard<mutex> lock(writerMutex);
+    graph.editEdge(origin, destination, weight);
+    dirty = true;
+}
+
+void ConcurrentGraph::publish() {
+    lock_guard<mutex> lock(writerMutex);
+    publishLocked();
+}
+
+void ConcurrentGraph::update(const function<void(Graph&)>& mutations) {
+    lock_guard<mutex> lock(writerMutex);
+    dirty = true;
+    mutations(graph);
+}
@@ -0,0 +1,62 @@
+#ifndef CONCURRENTGRAPH_H_INCLUDED
+#define CONCURRENTGRAPH_H_INCLUDED
+
+#include <string>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <functional>
+#include "graph.h"
+#include "csrgraph.h"
+
+/// -------- CONCURRENT GRAPH PROTOTYPE --------
+/* A Graph shared by one writer and any number of readers. Mutations go to
+a private Graph under a mutex that only writers take and just mark it
+dirty. Publishing freezes it into a new CsrGraph and swaps it in
+atomically, so a reader holding a snapshot keeps a consistent version
+for as long as it wants. A snapshot is freed when its last reader drops
+it. Readers only get the CsrGraph API: ids, labels, traverses, routes and
+the other read-only algorithms, never the mutable Graph.
+
+Freezing costs O(V + E), so it happens once per batch of writes instead
+of once per write: when publish() is called, or when snapshot() finds
+the Graph dirty and no writer holding the mutex. In that case the reader
+publishes, otherwise it takes the last version without waiting. Writers
+never freeze the Graph themselves. */
+class ConcurrentGraph{
+private:
+    Graph graph;
+    std::mutex writerMutex;
+    std::shared_ptr<const CsrGraph> current;
+    std::atomic<bool> dirty;
+
+    void publishLocked();
+
+public:
+    ConcurrentGraph();
+    explicit ConcurrentGraph(const Graph&);
+
+    ConcurrentGraph(const ConcurrentGraph&) = delete;
+    ConcurrentGraph& operator = (const ConcurrentGraph&) = delete;
+
+    /* Latest version, it never changes once taken. */
+    std::shared_ptr<const CsrGraph> snapshot();
+
+    /* Mutations are seen by the next snapshot() that publishes. Each one
+    takes the mutex on its own, so group with update() the ones that must
+    never be seen apart. */
+    void insertVertex(const std::string&);
+    void deleteVertex(const std::string&);
+    void editVertex(const std::string&, const std::string&);
+    void insertEdge(const std::string&, const std::string&, const int&);
+    void deleteEdge(const std::string&, const std::string&);
+    void editEdge(const std::string&, const std::string&, const int&);
+    void publish();
+
+    /* Runs several mutations as one writer step, so they are published
+    together. If the function throws, what it already changed stays and
+    is published with the next version. */
+    void update(const std::function<void(Graph&)>&);
+};
+
+#endif // CONCURRENTGRAPH_H_INCLUDED
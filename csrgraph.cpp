@@ -0,0 +1,940 @@
+#include "csrgraph.h"
+#include "graph.h"
+#include <queue>
+#include <tuple>
+#include <algorithm>
+#include <iterator>
+#include <fstream>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <limits>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include "dheap.h"
+
+using namespace std;
+
+/// --- BINARY FILE FORMAT ---
+namespace {
+    const char fileMagic[8] = {'D', 'G', 'R', 'A', 'P', 'H', 'B', '\0'};
+    /* Version 1 always had the weights, version 2 leaves them out of
+    unweighted graphs. */
+    const uint32_t fileVersion = 2;
+    const uint32_t byteOrderMark = 0x01020304;
+    const uint32_t directedFlag = 1;
+    const uint32_t weightedFlag = 2;
+
+    struct FileHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t byteOrder;
+        uint32_t flags;
+        uint32_t reserved;
+        uint64_t numVertices;
+        uint64_t numEdges;
+        uint64_t numLabelChars;
+        uint64_t checksum;
+    };
+
+    /* Position of every array in the file. Each one starts on an 8 byte
+    boundary and the gaps are filled with zeros. */
+    struct FileLayout {
+        uint64_t offsets;
+        uint64_t labelOffsets;
+        uint64_t labelOrder;
+        uint64_t destinations;
+        uint64_t weights;
+        uint64_t labelChars;
+        uint64_t size;
+    };
+
+    uint64_t align8(const uint64_t& size) {
+        return (size + 7) & ~uint64_t(7);
+    }
+
+    FileLayout getLayout(const uint64_t& numVertices, const uint64_t& numEdges, const uint64_t& numLabelChars, const bool& hasWeights) {
+        FileLayout layout;
+
+        layout.offsets = sizeof(FileHeader);
+        layout.labelOffsets = layout.offsets + (numVertices + 1) * sizeof(uint64_t);
+        layout.labelOrder = layout.labelOffsets + (numVertices + 1) * sizeof(uint64_t);
+        layout.destinations = align8(layout.labelOrder + numVertices * sizeof(VertexId));
+        layout.weights = align8(layout.destinations + numEdges * sizeof(VertexId));
+        layout.labelChars = align8(layout.weights + (hasWeights ? numEdges * sizeof(int) : 0));
+        layout.size = align8(layout.labelChars + numLabelChars);
+
+        return layout;
+    }
+
+    /* FNV-1a over 64 bit words, the last one padded with zeros. Hashing the
+    arrays one after the other gives the same value as hashing the file. */
+    const uint64_t checksumBasis = 14695981039346656037ULL;
+
+    uint64_t checksumWords(uint64_t hash, const char* data, const uint64_t& size) {
+        uint64_t word;
+        uint64_t i(0);
+
+        for(; i + 8 <= size; i += 8){
+            memcpy(&word, data + i, 8);
+            hash = (hash ^ word) * 1099511628211ULL;
+        }
+        if(i < size){
+            word = 0;
+            memcpy(&word, data + i, size - i);
+            hash = (hash ^ word) * 1099511628211ULL;
+        }
+
+        return hash;
+    }
+
+    void writeSection(ofstream& myFile, uint64_t& hash, const void* data, const uint64_t& size) {
+        const char zeros[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+
+        myFile.write(static_cast<const char*>(data), size);
+        myFile.write(zeros, align8(size) - size);
+        hash = checksumWords(hash, static_cast<const char*>(data), size);
+    }
+}
+
+/// --- THREADS ---
+namespace {
+    /* Runs the task once per thread, the calling thread being number 0. */
+    void parallelFor(const unsigned& numThreads, const function<void(const unsigned&)>& task) {
+        vector <thread> workers;
+        for(unsigned t(1); t < numThreads; t++){
+            workers.emplace_back(task, t);
+        }
+        task(0);
+        for(vector<thread>::iterator it(workers.begin()); it != workers.end(); it++){
+            it->join();
+        }
+    }
+}
+
+/// --- PRIVATE METHODS ---
+void CsrGraph::pointToStorage() {
+    numVertices = offsetStorage.size() - 1;
+    numEdges = destinationStorage.size();
+    offsets = offsetStorage.data();
+    destinations = destinationStorage.data();
+    weights = weightStorage.empty() ? nullptr : weightStorage.data();
+    labelOffsets = labelOffsetStorage.data();
+    labelOrder = labelOrderStorage.data();
+    labelChars = labelStorage.data();
+    inOffsets = inOffsetStorage.empty() ? nullptr : inOffsetStorage.data();
+    sources = sourceStorage.data();
+}
+
+void CsrGraph::buildLabelOrder() {
+    labelOrderStorage.resize(numVertices);
+    for(VertexId i(0); i < numVertices; i++){
+        labelOrderStorage[i] = i;
+    }
+    labelOrder = labelOrderStorage.data();
+
+    sort(labelOrderStorage.begin(), labelOrderStorage.end(), [this](const VertexId& a, const VertexId& b) {
+        return getLabelView(a) < getLabelView(b);
+    });
+}
+
+void CsrGraph::release() {
+    if(mapping != nullptr){
+        munmap(mapping, mappingSize);
+        mapping = nullptr;
+        mappingSize = 0;
+    }
+
+    offsetStorage.assign(1, 0);
+    destinationStorage.clear();
+    weightStorage.clear();
+    labelOffsetStorage.assign(1, 0);
+    labelOrderStorage.clear();
+    labelStorage.clear();
+    inOffsetStorage.clear();
+    sourceStorage.clear();
+    pointToStorage();
+}
+
+void CsrGraph::copyInEdges(const CsrGraph& g) {
+    if(g.inOffsets == g.offsets){
+        inOffsets = offsets;
+        sources = destinations;
+    }
+    else if(g.inOffsets != nullptr){
+        inOffsetStorage.assign(g.inOffsets, g.inOffsets + numVertices + 1);
+        sourceStorage.assign(g.sources, g.sources + numEdges);
+        inOffsets = inOffsetStorage.data();
+        sources = sourceStorage.data();
+    }
+}
+
+string_view CsrGraph::getLabelView(const VertexId& id) const {
+    return string_view(labelChars + labelOffsets[id], labelOffsets[id + 1] - labelOffsets[id]);
+}
+
+vector<VertexId> CsrGraph::getRoute(const vector<VertexId>& parent, const VertexId& origin, const VertexId& destination) const {
+    vector <VertexId> route;
+
+    route.push_back(destination);
+    while(route.back() != origin){
+        route.push_back(parent[route.back()]);
+    }
+    reverse(route.begin(), route.end());
+
+    return route;
+}
+
+ShortestPath CsrGraph::shortestRoute(const VertexId& origin, const VertexId& destination, const RouteHeuristic* heuristic) const {
+    if(origin >= numVertices || destination >= numVertices){
+        throw GraphException("shortestRoute: at least one of the vertices doesn't exists.");
+    }
+
+    const long long infinite(numeric_limits<long long>::max());
+    vector <long long> cost(numVertices, infinite);
+    vector <VertexId> parent(numVertices);
+    DaryHeap <long long> myHeap(numVertices);
+    ShortestPath result;
+    result.cost = 0;
+
+    cost[origin] = 0;
+    myHeap.push(origin, heuristic == nullptr ? 0 : (*heuristic)(origin));
+    while(!myHeap.isEmpty()){
+        VertexId currentVertex(myHeap.pop());
+
+        if(currentVertex == destination){
+            result.cost = cost[destination];
+            result.vertices = getRoute(parent, origin, destination);
+            return result;
+        }
+
+        for(uint64_t i(offsets[currentVertex]); i < offsets[currentVertex + 1]; i++){
+            int weight(getWeight(i));
+            if(weight < 0){
+                throw GraphException("shortestRoute: negative weights are not allowed.");
+            }
+
+            VertexId dest(destinations[i]);
+            if(cost[currentVertex] + weight < cost[dest]){
+                cost[dest] = cost[currentVertex] + weight;
+                parent[dest] = currentVertex;
+                myHeap.push(dest, heuristic == nullptr ? cost[dest] : cost[dest] + (*heuristic)(dest));
+            }
+        }
+    }
+
+    return result;
+}
+
+/// --- PUBLIC METHODS ---
+CsrGraph::CsrGraph() : isDirected(true), isWeighted(true), mapping(nullptr), mappingSize(0) {
+    release();
+}
+
+CsrGraph::CsrGraph(const CsrGraph& g) : mapping(nullptr), mappingSize(0) {
+    *this = g;
+}
+
+CsrGraph::CsrGraph(CsrGraph&& g) : mapping(nullptr), mappingSize(0) {
+    *this = move(g);
+}
+
+CsrGraph::~CsrGraph() {
+    release();
+}
+
+CsrGraph& CsrGraph::operator = (const CsrGraph& g) {
+    if(this != &g){
+        release();
+        isDirected = g.isDirected;
+        isWeighted = g.isWeighted;
+        offsetStorage.assign(g.offsets, g.offsets + g.numVertices + 1);
+        destinationStorage.assign(g.destinations, g.destinations + g.numEdges);
+        if(g.weights != nullptr){
+            weightStorage.assign(g.weights, g.weights + g.numEdges);
+        }
+        labelOffsetStorage.assign(g.labelOffsets, g.labelOffsets + g.numVertices + 1);
+        labelOrderStorage.assign(g.labelOrder, g.labelOrder + g.numVertices);
+        labelStorage.assign(g.labelChars, g.labelChars + g.labelOffsets[g.numVertices]);
+        pointToStorage();
+        copyInEdges(g);
+    }
+    return *this;
+}
+
+/* Moving a vector keeps its buffer, so the pointers stay valid. */
+CsrGraph& CsrGraph::operator = (CsrGraph&& g) {
+    if(this != &g){
+        release();
+        isDirected = g.isDirected;
+        isWeighted = g.isWeighted;
+        numVertices = g.numVertices;
+        numEdges = g.numEdges;
+        offsets = g.offsets;
+        destinations = g.destinations;
+        weights = g.weights;
+        labelOffsets = g.labelOffsets;
+        labelOrder = g.labelOrder;
+        labelChars = g.labelChars;
+        inOffsets = g.inOffsets;
+        sources = g.sources;
+        offsetStorage = move(g.offsetStorage);
+        destinationStorage = move(g.destinationStorage);
+        weightStorage = move(g.weightStorage);
+        labelOffsetStorage = move(g.labelOffsetStorage);
+        labelOrderStorage = move(g.labelOrderStorage);
+        labelStorage = move(g.labelStorage);
+        inOffsetStorage = move(g.inOffsetStorage);
+        sourceStorage = move(g.sourceStorage);
+        mapping = g.mapping;
+        mappingSize = g.mappingSize;
+
+        g.mapping = nullptr;
+        g.mappingSize = 0;
+        g.release();
+    }
+    return *this;
+}
+
+bool CsrGraph::isEmpty() const {
+    return numVertices == 0;
+}
+
+bool CsrGraph::getIsDirected() const {
+    return isDirected;
+}
+
+bool CsrGraph::getIsWeighted() const {
+    return isWeighted;
+}
+
+VertexId CsrGraph::getNumVertices() const {
+    return numVertices;
+}
+
+uint64_t CsrGraph::getNumEdges() const {
+    return numEdges;
+}
+
+uint64_t CsrGraph::getDegree(const VertexId& id) const {
+    if(id >= numVertices){
+        throw GraphException("getDegree: there is not such vertex.");
+    }
+
+    return offsets[id + 1] - offsets[id];
+}
+
+void CsrGraph::buildInEdges() {
+    if(inOffsets != nullptr){
+        return;
+    }
+    if(!isDirected){
+        inOffsets = offsets;
+        sources = destinations;
+        return;
+    }
+
+    inOffsetStorage.assign(numVertices + 1, 0);
+    for(uint64_t i(0); i < numEdges; i++){
+        inOffsetStorage[destinations[i] + 1]++;
+    }
+    for(VertexId v(0); v < numVertices; v++){
+        inOffsetStorage[v + 1] += inOffsetStorage[v];
+    }
+
+    vector <uint64_t> next(inOffsetStorage.begin(), inOffsetStorage.end() - 1);
+    sourceStorage.resize(numEdges);
+    for(VertexId v(0); v < numVertices; v++){
+        for(uint64_t i(offsets[v]); i < offsets[v + 1]; i++){
+            sourceStorage[next[destinations[i]]++] = v;
+        }
+    }
+
+    inOffsets = inOffsetStorage.data();
+    sources = sourceStorage.data();
+}
+
+bool CsrGraph::hasInEdges() const {
+    return inOffsets != nullptr;
+}
+
+VertexId CsrGraph::getVertexId(const string& label) const {
+    const VertexId* it(lower_bound(labelOrder, labelOrder + numVertices, label, [this](const VertexId& a, const string& b) {
+        return getLabelView(a) < string_view(b);
+    }));
+    if(it == labelOrder + numVertices || getLabelView(*it) != label){
+        throw GraphException("getVertexId: there is not such vertex.");
+    }
+
+    return *it;
+}
+
+string CsrGraph::getVertexLabel(const VertexId& id) const {
+    if(id >= numVertices){
+        throw GraphException("getVertexLabel: there is not such vertex.");
+    }
+
+    return string(getLabelView(id));
+}
+
+void CsrGraph::saveToFile(const string& fileName) const {
+    ofstream myFile(fileName, ios::trunc | ios::binary);
+    if(!myFile.good()){
+        throw GraphException("saveToFile: the file can't be opened.");
+    }
+
+    FileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, fileMagic, sizeof(fileMagic));
+    header.version = fileVersion;
+    header.byteOrder = byteOrderMark;
+    header.flags = (isDirected ? directedFlag : 0) | (isWeighted ? weightedFlag : 0);
+    header.numVertices = numVertices;
+    header.numEdges = numEdges;
+    header.numLabelChars = labelOffsets[numVertices];
+    myFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    uint64_t hash(checksumBasis);
+    writeSection(myFile, hash, offsets, (numVertices + 1) * sizeof(uint64_t));
+    writeSection(myFile, hash, labelOffsets, (numVertices + 1) * sizeof(uint64_t));
+    writeSection(myFile, hash, labelOrder, numVertices * sizeof(VertexId));
+    writeSection(myFile, hash, destinations, numEdges * sizeof(VertexId));
+    if(isWeighted){
+        writeSection(myFile, hash, weights, numEdges * sizeof(int));
+    }
+    writeSection(myFile, hash, labelChars, header.numLabelChars);
+
+    header.checksum = hash;
+    myFile.seekp(0);
+    myFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    myFile.close();
+    if(myFile.fail()){
+        throw GraphException("saveToFile: the file couldn't be written.");
+    }
+}
+
+bool CsrGraph::getFromFile(const string& fileName, const bool& verify) {
+    int fd(open(fileName.c_str(), O_RDONLY));
+    if(fd < 0){
+        return false;
+    }
+
+    struct stat fileInfo;
+    if(fstat(fd, &fileInfo) != 0 || fileInfo.st_size < (off_t)sizeof(FileHeader)){
+        close(fd);
+        throw GraphException("getFromFile: not a graph file.");
+    }
+
+    size_t fileSize(fileInfo.st_size);
+    void* data(mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0));
+    close(fd);
+    if(data == MAP_FAILED){
+        throw GraphException("getFromFile: the file can't be mapped.");
+    }
+
+    const char* bytes(static_cast<const char*>(data));
+    FileHeader header;
+    memcpy(&header, bytes, sizeof(header));
+
+    const char* error(nullptr);
+    FileLayout layout;
+    if(memcmp(header.magic, fileMagic, sizeof(fileMagic)) != 0){
+        error = "getFromFile: not a graph file.";
+    }
+    else if(header.version < 1 || header.version > fileVersion || header.byteOrder != byteOrderMark){
+        error = "getFromFile: unsupported version or byte order.";
+    }
+    else if(header.numVertices >= UINT32_MAX || header.numEdges > fileSize || header.numLabelChars > fileSize
+            || (layout = getLayout(header.numVertices, header.numEdges, header.numLabelChars,
+                                (header.flags & weightedFlag) || header.version == 1)).size != fileSize){
+        error = "getFromFile: the file is truncated or has a wrong size.";
+    }
+    else{
+        const uint64_t* fileOffsets(reinterpret_cast<const uint64_t*>(bytes + layout.offsets));
+        const uint64_t* fileLabelOffsets(reinterpret_cast<const uint64_t*>(bytes + layout.labelOffsets));
+
+        if(fileOffsets[0] != 0 || fileOffsets[header.numVertices] != header.numEdges
+           || fileLabelOffsets[0] != 0 || fileLabelOffsets[header.numVertices] != header.numLabelChars){
+            error = "getFromFile: the arrays are corrupted.";
+        }
+        else if(verify){
+            if(checksumWords(checksumBasis, bytes + sizeof(FileHeader), fileSize - sizeof(FileHeader)) != header.checksum){
+                error = "getFromFile: wrong checksum.";
+            }
+
+            const VertexId* fileDestinations(reinterpret_cast<const VertexId*>(bytes + layout.destinations));
+            const VertexId* fileLabelOrder(reinterpret_cast<const VertexId*>(bytes + layout.labelOrder));
+            for(uint64_t i(0); error == nullptr && i < header.numVertices; i++){
+                if(fileOffsets[i] > fileOffsets[i + 1] || fileLabelOffsets[i] > fileLabelOffsets[i + 1]
+                   || fileLabelOrder[i] >= header.numVertices){
+                    error = "getFromFile: the arrays are corrupted.";
+                }
+            }
+            for(uint64_t i(0); error == nullptr && i < header.numEdges; i++){
+                if(fileDestinations[i] >= header.numVertices){
+                    error = "getFromFile: the arrays are corrupted.";
+                }
+            }
+        }
+    }
+
+    if(error != nullptr){
+        munmap(data, fileSize);
+        throw GraphException(error);
+    }
+
+    release();
+    mapping = data;
+    mappingSize = fileSize;
+    isDirected = header.flags & directedFlag;
+    isWeighted = header.flags & weightedFlag;
+    numVertices = header.numVertices;
+    numEdges = header.numEdges;
+    offsets = reinterpret_cast<const uint64_t*>(bytes + layout.offsets);
+    labelOffsets = reinterpret_cast<const uint64_t*>(bytes + layout.labelOffsets);
+    labelOrder = reinterpret_cast<const VertexId*>(bytes + layout.labelOrder);
+    destinations = reinterpret_cast<const VertexId*>(bytes + layout.destinations);
+    weights = isWeighted && numEdges != 0 ? reinterpret_cast<const int*>(bytes + layout.weights) : nullptr;
+    labelChars = bytes + layout.labelChars;
+
+    return true;
+}
+
+vector<VertexId> CsrGraph::breadthFirstTraverse(const VertexId& origin) const {
+    vector <VertexId> traverse;
+    breadthFirstTraverse(origin, back_inserter(traverse));
+    return traverse;
+}
+
+vector<VertexId> CsrGraph::depthFirstTraverse(const VertexId& origin) const {
+    vector <VertexId> traverse;
+    depthFirstTraverse(origin, back_inserter(traverse));
+    return traverse;
+}
+
+void CsrGraph::breadthFirstVisit(const VertexId& origin, const TraverseVisitor& visitor) const {
+    if(origin >= numVertices){
+        throw GraphException("breadthFirstTraverse: there is not such vertex.");
+    }
+
+    vector <bool> queued(numVertices, false);
+    vector <VertexId> myQueue;
+    size_t front(0);
+
+    myQueue.push_back(origin);
+    queued[origin] = true;
+    while(front < myQueue.size()){
+        VertexId currentVertex(myQueue[front++]);
+        if(!visitor(currentVertex)){
+            return;
+        }
+
+        for(uint64_t i(offsets[currentVertex]); i < offsets[currentVertex + 1]; i++){
+            if(!queued[destinations[i]]){
+                queued[destinations[i]] = true;
+                myQueue.push_back(destinations[i]);
+            }
+        }
+    }
+}
+
+void CsrGraph::depthFirstVisit(const VertexId& origin, const TraverseVisitor& visitor) const {
+    if(origin >= numVertices){
+        throw GraphException("depthFirstTraverse: there is not such vertex.");
+    }
+
+    vector <bool> visited(numVertices, false);
+    vector <VertexId> myStack;
+
+    myStack.push_back(origin);
+    while(!myStack.empty()){
+        VertexId currentVertex(myStack.back());
+        myStack.pop_back();
+
+        if(!visited[currentVertex]){
+            visited[currentVertex] = true;
+            if(!visitor(currentVertex)){
+                return;
+            }
+
+            for(uint64_t i(offsets[currentVertex]); i < offsets[currentVertex + 1]; i++){
+                if(!visited[destinations[i]]){
+                    myStack.push_back(destinations[i]);
+                }
+            }
+        }
+    }
+}
+
+vector<VertexId> CsrGraph::breadthFirstRoute(const VertexId& origin, const VertexId& destination) const {
+    if(origin >= numVertices || destination >= numVertices){
+        throw GraphException("breadthFirstRoute: at least one of the vertices doesn't exists.");
+    }
+
+    vector <bool> visited(numVertices, false);
+    vector <bool> queued(numVertices, false);
+    vector <VertexId> parent(numVertices);
+    vector <VertexId> myQueue;
+    size_t front(0);
+
+    myQueue.push_back(origin);
+    queued[origin] = true;
+    while(front < myQueue.size()){
+        VertexId currentVertex(myQueue[front++]);
+
+        if(currentVertex == destination){
+            return getRoute(parent, origin, destination);
+        }
+
+        visited[currentVertex] = true;
+
+        for(uint64_t i(offsets[currentVertex]); i < offsets[currentVertex + 1]; i++){
+            VertexId dest(destinations[i]);
+            if(!visited[dest]){
+                parent[dest] = currentVertex;
+                if(!queued[dest]){
+                    queued[dest] = true;
+                    myQueue.push_back(dest);
+                }
+            }
+        }
+    }
+
+    return vector<VertexId>();
+}
+
+vector<VertexId> CsrGraph::depthFirstRoute(const VertexId& origin, const VertexId& destination) const {
+    if(origin >= numVertices || destination >= numVertices){
+        throw GraphException("depthFirstRoute: at least one of the vertices doesn't exists.");
+    }
+
+    vector <bool> visited(numVertices, false);
+    vector <VertexId> parent(numVertices);
+    vector <VertexId> myStack;
+
+    myStack.push_back(origin);
+    while(!myStack.empty()){
+        VertexId currentVertex(myStack.back());
+        myStack.pop_back();
+
+        if(!visited[currentVertex]){
+            if(currentVertex == destination){
+                return getRoute(parent, origin, destination);
+            }
+
+            visited[currentVertex] = true;
+
+            for(uint64_t i(offsets[currentVertex]); i < offsets[currentVertex + 1]; i++){
+                if(!visited[destinations[i]]){
+                    myStack.push_back(destinations[i]);
+                    parent[destinations[i]] = currentVertex;
+                }
+            }
+        }
+    }
+
+    return vector<VertexId>();
+}
+
+vector<WeightedEdge> CsrGraph::primSpanningTree(const VertexId& origin) const {
+    if(origin >= numVertices){
+        throw GraphException("primSpanningTree: there is not such vertex.");
+    }
+
+    vector <WeightedEdge> treeEdges;
+    vector <bool> visited(numVertices, false);
+    tuple <VertexId, VertexId, int> tempEdge;
+
+    class myGreater {
+    public:
+      bool operator () (const tuple <VertexId, VertexId, int>& a, const tuple <VertexId, VertexId, int>& b) const {
+        return get<2>(a) > get<2>(b);
+      }
+    };
+
+    priority_queue <tuple <VertexId, VertexId, int>, vector <tuple <VertexId, VertexId, int>>, myGreater> priQueue;
+
+    visited[origin] = true;
+    for(uint64_t i(offsets[origin]); i < offsets[origin + 1]; i++){
+        priQueue.push(make_tuple(origin, destinations[i], getWeight(i)));
+    }
+
+    while(!priQueue.empty()){
+        tempEdge = priQueue.top();
+        priQueue.pop();
+
+        VertexId currentVertex(get<1>(tempEdge));
+        if(!visited[currentVertex]){
+            visited[currentVertex] = true;
+
+            for(uint64_t i(offsets[currentVertex]); i < offsets[currentVertex + 1]; i++){
+                priQueue.push(make_tuple(currentVertex, destinations[i], getWeight(i)));
+            }
+
+            treeEdges.push_back(WeightedEdge{get<0>(tempEdge), currentVertex, get<2>(tempEdge)});
+        }
+    }
+    return treeEdges;
+}
+
+/* Every round each component picks its lightest outgoing edge and all of
+them are joined at once. Ties are broken by the endpoints, so the picked
+edges never close a cycle. The search for the lightest edges is split by
+vertex ranges among the threads and the joins are done after them. */
+vector<WeightedEdge> CsrGraph::minimumSpanningForest(const unsigned& numThreads) const {
+    const size_t minParallelWork(4096);
+
+    unsigned threads(numThreads != 0 ? numThreads : thread::hardware_concurrency());
+    if(threads == 0){
+        threads = 1;
+    }
+    unsigned active(numVertices < minParallelWork ? 1 : threads);
+
+    vector <WeightedEdge> forestEdges;
+    vector <VertexId> edgeOrigins(numEdges);
+    vector <VertexId> parent(numVertices);
+    vector <VertexId> component(numVertices);
+    unique_ptr <atomic<uint64_t>[]> lightest(new atomic<uint64_t>[numVertices]);
+
+    parallelFor(active, [&](const unsigned& t) {
+        VertexId first(uint64_t(numVertices) * t / active);
+        VertexId last(uint64_t(numVertices) * (t + 1) / active);
+
+        for(VertexId v(first); v < last; v++){
+            for(uint64_t i(offsets[v]); i < offsets[v + 1]; i++){
+                edgeOrigins[i] = v;
+            }
+            parent[v] = v;
+            component[v] = v;
+        }
+    });
+
+    auto findRoot = [&parent](VertexId v) {
+        while(parent[v] != v){
+            parent[v] = parent[parent[v]];
+            v = parent[v];
+        }
+        return v;
+    };
+
+    /* Edges are stored as index + 1 so that 0 means no edge. */
+    auto isLighter = [&](const uint64_t& a, const uint64_t& b) {
+        if(b == 0){
+            return true;
+        }
+        if(getWeight(a - 1) != getWeight(b - 1)){
+            return getWeight(a - 1) < getWeight(b - 1);
+        }
+        VertexId aLow(min(edgeOrigins[a - 1], destinations[a - 1]));
+        VertexId bLow(min(edgeOrigins[b - 1], destinations[b - 1]));
+        if(aLow != bLow){
+            return aLow < bLow;
+        }
+        return max(edgeOrigins[a - 1], destinations[a - 1]) < max(edgeOrigins[b - 1], destinations[b - 1]);
+    };
+
+    auto offerEdge = [&](atomic<uint64_t>& best, const uint64_t& candidate) {
+        uint64_t current(best.load(memory_order_relaxed));
+        while(isLighter(candidate, current)){
+            if(best.compare_exchange_weak(current, candidate, memory_order_relaxed)){
+                break;
+            }
+        }
+    };
+
+    bool joined(true);
+    while(joined){
+        parallelFor(active, [&](const unsigned& t) {
+            VertexId first(uint64_t(numVertices) * t / active);
+            VertexId last(uint64_t(numVertices) * (t + 1) / active);
+            for(VertexId v(first); v < last; v++){
+                lightest[v].store(0, memory_order_relaxed);
+            }
+        });
+
+        parallelFor(active, [&](const unsigned& t) {
+            VertexId first(uint64_t(numVertices) * t / active);
+            VertexId last(uint64_t(numVertices) * (t + 1) / active);
+
+            for(VertexId v(first); v < last; v++){
+                uint64_t best(0);
+                for(uint64_t i(offsets[v]); i < offsets[v + 1]; i++){
+                    VertexId destComponent(component[destinations[i]]);
+                    if(destComponent != component[v]){
+                        if(isLighter(i + 1, best)){
+                            best = i + 1;
+                        }
+                        /* Undirected graphs also keep the reverse edge, which
+                        is offered from the destination itself. */
+                        if(isDirected){
+                            offerEdge(lightest[destComponent], i + 1);
+                        }
+                    }
+                }
+                if(best != 0){
+                    offerEdge(lightest[component[v]], best);
+                }
+            }
+        });
+
+        joined = false;
+        for(VertexId c(0); c < numVertices; c++){
+            uint64_t best(lightest[c].load(memory_order_relaxed));
+            if(best != 0){
+                VertexId originRoot(findRoot(edgeOrigins[best - 1]));
+                VertexId destRoot(findRoot(destinations[best - 1]));
+                if(originRoot != destRoot){
+                    parent[originRoot] = destRoot;
+                    forestEdges.push_back(WeightedEdge{edgeOrigins[best - 1], destinations[best - 1], getWeight(best - 1)});
+                    joined = true;
+                }
+            }
+        }
+
+        if(joined){
+            for(VertexId v(0); v < numVertices; v++){
+                component[v] = findRoot(v);
+            }
+        }
+    }
+
+    return forestEdges;
+}
+
+ShortestPath CsrGraph::dijkstraRoute(const VertexId& origin, const VertexId& destination) const {
+    return shortestRoute(origin, destination, nullptr);
+}
+
+ShortestPath CsrGraph::aStarRoute(const VertexId& origin, const VertexId& destination, const RouteHeuristic& heuristic) const {
+    return shortestRoute(origin, destination, &heuristic);
+}
+
+/* Direction optimizing search: a level goes bottom-up when the edges leaving
+the frontier are more than 1/14 of the edges still unexplored, and back
+top-down when the frontier is under 1/24 of the vertices. Levels with
+little work run on the calling thread only. */
+BreadthFirstLevels CsrGraph::parallelBreadthFirstSearch(const VertexId& origin, const unsigned& numThreads) const {
+    if(origin >= numVertices){
+        throw GraphException("parallelBreadthFirstSearch: there is not such vertex.");
+    }
+
+    const uint64_t alpha(14);
+    const uint64_t beta(24);
+    const size_t minParallelWork(4096);
+    const uint32_t unreached(BreadthFirstLevels::unreachedDistance);
+
+    unsigned threads(numThreads != 0 ? numThreads : thread::hardware_concurrency());
+    if(threads == 0){
+        threads = 1;
+    }
+
+    const uint64_t* revOffsets(isDirected ? inOffsets : offsets);
+    const VertexId* revSources(isDirected ? sources : destinations);
+
+    BreadthFirstLevels result;
+    result.distance.assign(numVertices, unreached);
+    result.parent.assign(numVertices, origin);
+
+    size_t numWords((numVertices + 63) / 64);
+    unique_ptr <atomic<uint64_t>[]> visited(new atomic<uint64_t>[numWords]);
+    for(size_t i(0); i < numWords; i++){
+        visited[i].store(0, memory_order_relaxed);
+    }
+    vector <uint64_t> inFrontier;
+
+    vector <VertexId> frontier(1, origin);
+    vector <vector <VertexId>> nextFrontiers(threads);
+    vector <uint64_t> nextDegrees(threads);
+    visited[origin / 64].store(uint64_t(1) << (origin % 64), memory_order_relaxed);
+    result.distance[origin] = 0;
+
+    uint64_t edgesToCheck(offsets[origin + 1] - offsets[origin]);
+    uint64_t edgesUnexplored(numEdges - edgesToCheck);
+    bool bottomUp(false);
+    uint32_t level(0);
+
+    while(!frontier.empty()){
+        if(revOffsets != nullptr){
+            if(!bottomUp && edgesToCheck > edgesUnexplored / alpha){
+                bottomUp = true;
+            }
+            else if(bottomUp && frontier.size() < numVertices / beta){
+                bottomUp = false;
+            }
+        }
+
+        size_t work(bottomUp ? numVertices : frontier.size());
+        unsigned active(work < minParallelWork ? 1 : threads);
+
+        if(!bottomUp){
+            parallelFor(active, [&](const unsigned& t) {
+                vector <VertexId>& next(nextFrontiers[t]);
+                size_t first(frontier.size() * t / active);
+                size_t last(frontier.size() * (t + 1) / active);
+
+                for(size_t f(first); f < last; f++){
+                    VertexId v(frontier[f]);
+                    for(uint64_t i(offsets[v]); i < offsets[v + 1]; i++){
+                        VertexId u(destinations[i]);
+                        uint64_t bit(uint64_t(1) << (u % 64));
+                        if(!(visited[u / 64].load(memory_order_relaxed) & bit)
+                           && !(visited[u / 64].fetch_or(bit, memory_order_relaxed) & bit)){
+                            result.distance[u] = level + 1;
+                            result.parent[u] = v;
+                            next.push_back(u);
+                            nextDegrees[t] += offsets[u + 1] - offsets[u];
+                        }
+                    }
+                }
+            });
+        }
+        else{
+            /* Frontier membership is read from its own bitmap, since the
+            distances are being written by the other threads. */
+            inFrontier.assign(numWords, 0);
+            for(vector<VertexId>::const_iterator it(frontier.begin()); it != frontier.end(); it++){
+                inFrontier[*it / 64] |= uint64_t(1) << (*it % 64);
+            }
+
+            parallelFor(active, [&](const unsigned& t) {
+                vector <VertexId>& next(nextFrontiers[t]);
+                VertexId first(uint64_t(numVertices) * t / active);
+                VertexId last(uint64_t(numVertices) * (t + 1) / active);
+
+                for(VertexId u(first); u < last; u++){
+                    if(result.distance[u] != unreached){
+                        continue;
+                    }
+                    for(uint64_t i(revOffsets[u]); i < revOffsets[u + 1]; i++){
+                        VertexId v(revSources[i]);
+                        if(inFrontier[v / 64] & (uint64_t(1) << (v % 64))){
+                            result.distance[u] = level + 1;
+                            result.parent[u] = v;
+                            visited[u / 64].fetch_or(uint64_t(1) << (u % 64), memory_order_relaxed);
+                            next.push_back(u);
+                            nextDegrees[t] += offsets[u + 1] - offsets[u];
+                            break;
+                        }
+                    }
+                }
+            });
+        }
+
+        frontier.clear();
+        edgesToCheck = 0;
+        for(unsigned t(0); t < threads; t++){
+            frontier.insert(frontier.end(), nextFrontiers[t].begin(), nextFrontiers[t].end());
+            nextFrontiers[t].clear();
+            edgesToCheck += nextDegrees[t];
+            nextDegrees[t] = 0;
+        }
+        edgesUnexplored -= edgesToCheck < edgesUnexplored ? edgesToCheck : edgesUnexplored;
+        level++;
+    }
+
+    return result;
+}
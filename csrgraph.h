@@ -0,0 +1,190 @@
+#ifndef CSRGRAPH_H_INCLUDED
+#define CSRGRAPH_H_INCLUDED
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include "vertex.h"
+
+template <class Weight>
+struct BasicWeightedEdge {
+    VertexId origin;
+    VertexId destination;
+    Weight weight;
+};
+
+typedef BasicWeightedEdge<int> WeightedEdge;
+
+/* Vertices from origin to destination, empty when there is no route. */
+template <class Cost>
+struct BasicShortestPath {
+    std::vector<VertexId> vertices;
+    Cost cost;
+};
+
+typedef BasicShortestPath<long long> ShortestPath;
+
+/* Called with every vertex of a traverse, returns false to stop it. */
+typedef std::function<bool(const VertexId&)> TraverseVisitor;
+
+/* Result of a parallel breadth-first search: hops from the origin and the
+parent of every vertex in the search tree. The origin is its own parent.
+Vertices that weren't reached have unreachedDistance and their parent
+means nothing. */
+struct BreadthFirstLevels {
+    static constexpr std::uint32_t unreachedDistance = UINT32_MAX;
+
+    std::vector<std::uint32_t> distance;
+    std::vector<VertexId> parent;
+};
+
+/* Estimate of the cost left from a vertex to the destination of A*. */
+typedef std::function<long long(const VertexId&)> RouteHeuristic;
+
+template <class Key, class Weight> class BasicGraph;
+
+/// -------- CSR GRAPH PROTOTYPE --------
+/* Immutable compressed sparse row snapshot of a Graph. The edges of vertex
+v are destinations[offsets[v]] .. destinations[offsets[v + 1] - 1], in the
+same order as in the Graph, and every array is contiguous so traversals
+don't chase pointers. Vertex ids are the same ones the Graph had.
+
+The arrays either live in vectors owned by the object or point straight
+into a binary file mapped by getFromFile(). Unweighted graphs keep no
+weights and every edge weighs 1, so an edge takes 4 bytes, or 8 with its
+weight. */
+class CsrGraph{
+private:
+    bool isDirected;
+    bool isWeighted;
+    VertexId numVertices;
+    std::uint64_t numEdges;
+
+    const std::uint64_t* offsets;
+    const VertexId* destinations;
+    const int* weights;
+
+    int getWeight(const std::uint64_t& i) const {
+        return weights == nullptr ? 1 : weights[i];
+    }
+
+    /* Labels are kept in a single buffer, labelOrder has the ids sorted by
+    label so getVertexId can binary search without building a hash. */
+    const std::uint64_t* labelOffsets;
+    const VertexId* labelOrder;
+    const char* labelChars;
+
+    /* Reverse adjacency (edges pointing to each vertex), only present
+    after buildInEdges(). On undirected graphs it is the adjacency itself. */
+    const std::uint64_t* inOffsets;
+    const VertexId* sources;
+
+    std::vector<std::uint64_t> offsetStorage;
+    std::vector<VertexId> destinationStorage;
+    std::vector<int> weightStorage;
+    std::vector<std::uint64_t> labelOffsetStorage;
+    std::vector<VertexId> labelOrderStorage;
+    std::vector<char> labelStorage;
+    std::vector<std::uint64_t> inOffsetStorage;
+    std::vector<VertexId> sourceStorage;
+
+    void* mapping;
+    std::size_t mappingSize;
+
+    void pointToStorage();
+    void buildLabelOrder();
+    void release();
+    std::string_view getLabelView(const VertexId&) const;
+    std::vector<VertexId> getRoute(const std::vector<VertexId>&, const VertexId&, const VertexId&) const;
+    ShortestPath shortestRoute(const VertexId&, const VertexId&, const RouteHeuristic*) const;
+    void copyInEdges(const CsrGraph&);
+
+public:
+    CsrGraph();
+
+    /* Defined along with BasicGraph. Labels are kept as text and weights
+    as int, so graphs with other weight types can't be frozen, and a wider
+    integral weight that doesn't fit in an int throws a GraphException. */
+    template <class Key, class Weight>
+    explicit CsrGraph(BasicGraph<Key, Weight>&);
+    CsrGraph(const CsrGraph&);
+    CsrGraph(CsrGraph&&);
+    ~CsrGraph();
+
+    CsrGraph& operator = (const CsrGraph&);
+    CsrGraph& operator = (CsrGraph&&);
+
+    bool isEmpty() const;
+    bool getIsDirected() const;
+    bool getIsWeighted() const;
+
+    VertexId getNumVertices() const;
+    std::uint64_t getNumEdges() const;
+    std::uint64_t getDegree(const VertexId&) const;
+
+    /* Builds the reverse adjacency used by the bottom-up steps of
+    parallelBreadthFirstSearch on directed graphs. */
+    void buildInEdges();
+    bool hasInEdges() const;
+
+    VertexId getVertexId(const std::string&) const;
+    std::string getVertexLabel(const VertexId&) const;
+
+    /* Binary format: a versioned header, then the CSR arrays and the
+    string table exactly as they are kept in memory, and a checksum of
+    everything after the header. getFromFile maps the file and reads it
+    in place, so loading doesn't copy or parse anything. The checksum
+    and the structure of the arrays are only verified when asked, since
+    that reads the whole file. Returns false if the file can't be opened
+    and throws a GraphException if it isn't a valid graph file. */
+    void saveToFile(const std::string&) const;
+    bool getFromFile(const std::string&, const bool& verify = true);
+
+    /* Same results as the id versions of the Graph methods. */
+    std::vector<VertexId> breadthFirstTraverse(const VertexId&) const;
+    std::vector<VertexId> depthFirstTraverse(const VertexId&) const;
+    void breadthFirstVisit(const VertexId&, const TraverseVisitor&) const;
+    void depthFirstVisit(const VertexId&, const TraverseVisitor&) const;
+
+    template <class OutputIt>
+    OutputIt breadthFirstTraverse(const VertexId& origin, OutputIt out) const {
+        breadthFirstVisit(origin, [&out](const VertexId& v) {
+            *out++ = v;
+            return true;
+        });
+        return out;
+    }
+
+    template <class OutputIt>
+    OutputIt depthFirstTraverse(const VertexId& origin, OutputIt out) const {
+        depthFirstVisit(origin, [&out](const VertexId& v) {
+            *out++ = v;
+            return true;
+        });
+        return out;
+    }
+    std::vector<VertexId> breadthFirstRoute(const VertexId&, const VertexId&) const;
+    std::vector<VertexId> depthFirstRoute(const VertexId&, const VertexId&) const;
+    std::vector<WeightedEdge> primSpanningTree(const VertexId&) const;
+
+    /* Minimum spanning forest using Boruvka's algorithm run by several
+    threads (0 uses every hardware thread). Edges are taken as undirected
+    and every connected component gets its own tree, so unlike Prim's
+    algorithm it doesn't need an origin. */
+    std::vector<WeightedEdge> minimumSpanningForest(const unsigned& numThreads = 0) const;
+
+    /* Level synchronous breadth-first search run by several threads (0 uses
+    every hardware thread). Each level is expanded top-down from the frontier
+    or, once the frontier gets large, bottom-up from the unvisited vertices,
+    which needs the in-edges on directed graphs. Reaches the same vertices at
+    the same distances as the serial traverse; with several parents at the
+    same distance any of them can be chosen. */
+    BreadthFirstLevels parallelBreadthFirstSearch(const VertexId&, const unsigned& numThreads = 0) const;
+    ShortestPath dijkstraRoute(const VertexId&, const VertexId&) const;
+    ShortestPath aStarRoute(const VertexId&, const VertexId&, const RouteHeuristic&) const;
+};
+
+#endif // CSRGRAPH_H_INCLUDED
@@ -0,0 +1,111 @@
+#ifndef DHEAP_H_INCLUDED
+#define DHEAP_H_INCLUDED
+
+#include <cstddef>
+#include <vector>
+#include "vertex.h"
+
+/// -------- D-ARY HEAP --------
+/* Min-heap of vertex ids with a position table, so the priority of a
+vertex already in the heap can be lowered in place instead of pushing a
+copy. A 4-ary heap is shallower than a binary one and its children share
+cache lines, which pays off with the many decrease-key calls of
+Dijkstra and A*. */
+template <class Priority>
+class DaryHeap{
+private:
+    static constexpr std::size_t arity = 4;
+    static constexpr std::size_t notInHeap = static_cast<std::size_t>(-1);
+
+    std::vector<VertexId> heap;
+    std::vector<std::size_t> position;
+    std::vector<Priority> priority;
+
+    void place(const std::size_t& i, const VertexId& v) {
+        heap[i] = v;
+        position[v] = i;
+    }
+
+    void siftUp(std::size_t i) {
+        VertexId v(heap[i]);
+        while(i > 0){
+            std::size_t parent((i - 1) / arity);
+            if(!(priority[v] < priority[heap[parent]])){
+                break;
+            }
+            place(i, heap[parent]);
+            i = parent;
+        }
+        place(i, v);
+    }
+
+    void siftDown(std::size_t i) {
+        VertexId v(heap[i]);
+        while(true){
+            std::size_t first(i * arity + 1);
+            if(first >= heap.size()){
+                break;
+            }
+
+            std::size_t last(first + arity < heap.size() ? first + arity : heap.size());
+            std::size_t best(first);
+            for(std::size_t c(first + 1); c < last; c++){
+                if(priority[heap[c]] < priority[heap[best]]){
+                    best = c;
+                }
+            }
+            if(!(priority[heap[best]] < priority[v])){
+                break;
+            }
+            place(i, heap[best]);
+            i = best;
+        }
+        place(i, v);
+    }
+
+public:
+    explicit DaryHeap(const std::size_t& numVertices) : position(numVertices, notInHeap), priority(numVertices) {}
+
+    bool isEmpty() const {
+        return heap.empty();
+    }
+
+    std::size_t size() const {
+        return heap.size();
+    }
+
+    bool contains(const VertexId& v) const {
+        return position[v] != notInHeap;
+    }
+
+    /* Inserts the vertex, or lowers its priority if it is already in. */
+    void push(const VertexId& v, const Priority& p) {
+        if(contains(v)){
+            if(p < priority[v]){
+                priority[v] = p;
+                siftUp(position[v]);
+            }
+        }
+        else{
+            priority[v] = p;
+            heap.push_back(v);
+            siftUp(heap.size() - 1);
+        }
+    }
+
+    VertexId pop() {
+        VertexId top(heap[0]);
+        position[top] = notInHeap;
+
+        VertexId last(heap.back());
+        heap.pop_back();
+        if(!heap.empty()){
+            place(0, last);
+            siftDown(0);
+        }
+
+        return top;
+    }
+};
+
+#endif // DHEAP_H_INCLUDED
@@ -1,26 +1,78 @@
 #ifndef EDGE_H_INCLUDED
 #define EDGE_H_INCLUDED
 
+#include <string>
+#include <ostream>
 #include "vertex.h"
 
-class Vertex;
-class Edge{
+/* Weight type of graphs whose edges have no weight. Any weight given to
+them is accepted and dropped, and every edge weighs 1 when it's read. */
+struct Unweighted {
+    Unweighted() {}
+    Unweighted(const int&) {}
+};
+
+inline std::ostream& operator << (std::ostream& out, const Unweighted&) {
+    return out << 1;
+}
+
+/* Storage for the weight of an edge, it keeps nothing for Unweighted. */
+template <class Weight>
+class EdgeWeight{
+private:
+    Weight weight;
+
+public:
+    EdgeWeight() : weight() {}
+    EdgeWeight(const Weight& w) : weight(w) {}
+
+    Weight get() const { return weight; }
+    void set(const Weight& w) { weight = w; }
+};
+
+template <>
+class EdgeWeight<Unweighted>{
+public:
+    EdgeWeight() {}
+    EdgeWeight(const Unweighted&) {}
+
+    Unweighted get() const { return Unweighted(); }
+    void set(const Unweighted&) {}
+};
+
+template <class Key, class Weight> class BasicVertex;
+
+/* Edges only link forward and don't know their origin: the Graph finds
+the previous edge through the hub index or a short scan, and the origin
+through the in-edges of the destination when those are tracked. The
+in-index is the position of the edge among those in-edges. */
+template <class Key, class Weight>
+class BasicEdge{
 private:
-    int weight;
-    Edge* nextEdge;
+    typedef BasicVertex<Key, Weight> Vertex;
+
+    BasicEdge* nextEdge;
     Vertex* destVertex;
+    int inIndex;
+    EdgeWeight<Weight> weight;
 
 public:
-    Edge();
-    Edge(const int&);
+    BasicEdge() : nextEdge(nullptr), destVertex(nullptr), inIndex(-1) {}
+    BasicEdge(const Weight& w) : BasicEdge() {
+        weight.set(w);
+    }
 
-    int getWeight();
-    Edge* getNextEdge();
-    Vertex* getDestVertex();
+    Weight getWeight() { return weight.get(); }
+    BasicEdge* getNextEdge() { return nextEdge; }
+    Vertex* getDestVertex() { return destVertex; }
+    int getInIndex() { return inIndex; }
 
-    void setWeight(const int&);
-    void setNextEdge(Edge*);
-    void setDestVertex(Vertex*);
+    void setWeight(const Weight& w) { weight.set(w); }
+    void setNextEdge(BasicEdge* e) { nextEdge = e; }
+    void setDestVertex(Vertex* v) { destVertex = v; }
+    void setInIndex(const int& i) { inIndex = i; }
 };
 
+typedef BasicEdge<std::string, int> Edge;
+
 #endif // EDGE_H_INCLUDED
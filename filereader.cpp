@@ -0,0 +1,60 @@
+#include <algorithm>
+#include "filereader.h"
+#include "graph.h"
+
+using namespace std;
+
+size_t FileReader::countLines() {
+    size_t lines(0);
+    while(fill()){
+        lines += count(buffer.data(), buffer.data() + length, '\n');
+    }
+
+    file.clear();
+    file.seekg(0, ios::beg);
+    position = 0;
+    length = 0;
+    return lines;
+}
+
+int FileReader::readInt() {
+    while(peek() != EOF && isspace(peek())){
+        position++;
+    }
+
+    bool negative(peek() == '-');
+    if(negative || peek() == '+'){
+        position++;
+    }
+    if(peek() == EOF || !isdigit(peek())){
+        throw GraphException("getFromFile: the file is corrupted.");
+    }
+
+    long long value(0);
+    while(peek() != EOF && isdigit(peek())){
+        value = value * 10 + (buffer[position++] - '0');
+        if(value > (negative ? -(long long)INT_MIN : INT_MAX)){
+            throw GraphException("getFromFile: the file is corrupted.");
+        }
+    }
+    return negative ? -value : value;
+}
+
+void FileReader::readUntil(string& result, const char& delim) {
+    result.clear();
+    while(true){
+        if(peek() == EOF){
+            throw GraphException("getFromFile: the file is corrupted.");
+        }
+
+        const char* start(buffer.data() + position);
+        const char* found(static_cast<const char*>(memchr(start, delim, length - position)));
+        if(found != nullptr){
+            result.append(start, found - start);
+            position += found - start + 1;
+            return;
+        }
+        result.append(start, length - position);
+        position = length;
+    }
+}
@@ -0,0 +1,56 @@
+#ifndef FILEREADER_H_INCLUDED
+#define FILEREADER_H_INCLUDED
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstring>
+#include <cctype>
+#include <cstdio>
+#include <cstddef>
+#include <climits>
+
+/// -------- FILE READER --------
+/* Reads the text format of Graph::saveToFile through a large buffer instead
+of going through ifstream's formatted input for every value. Corrupted
+input throws a GraphException. */
+class FileReader {
+private:
+    std::ifstream file;
+    std::vector <char> buffer;
+    std::size_t position;
+    std::size_t length;
+
+    bool fill() {
+        file.read(buffer.data(), buffer.size());
+        length = file.gcount();
+        position = 0;
+        return length > 0;
+    }
+
+    int peek() {
+        if(position == length && !fill()){
+            return EOF;
+        }
+        return (unsigned char)buffer[position];
+    }
+
+public:
+    explicit FileReader(const std::string& fileName) : file(fileName, std::ios::binary), buffer(1 << 20), position(0), length(0) {}
+
+    bool good() {
+        return file.good();
+    }
+
+    /* Counts the lines of the whole file and goes back to its start. */
+    std::size_t countLines();
+
+    int readInt();
+    void readUntil(std::string&, const char&);
+
+    void ignore(const char& delim) {
+        while(peek() != EOF && buffer[position++] != delim){}
+    }
+};
+
+#endif // FILEREADER_H_INCLUDED
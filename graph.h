@@ -2,10 +2,22 @@
 #define GRAPH_H_INCLUDED
 
 #include <string>
-#include <stack>
+#include <string_view>
+#include <ostream>
+#include <sstream>
 #include <utility>
+#include <vector>
+#include <unordered_map>
+#include <functional>
+#include <type_traits>
+#include <limits>
 #include "vertex.h"
 #include "edge.h"
+#include "csrgraph.h"
+#include "nodepool.h"
+#include "graphstats.h"
+#include "querycontext.h"
+#include "querycache.h"
 
 /// -------- EXCEPTIONS --------
 class GraphException : public std::exception {
@@ -21,52 +33,286 @@ class GraphException : public std::exception {
     }
 };
 
+/// -------- MEMORY REPORT --------
+/* Bytes reserved by a Graph. Slabs are counted whole, so free slots
+left by deletions are included. Index bytes are an estimate. */
+struct GraphMemoryUsage {
+    std::size_t vertexBytes;
+    std::size_t edgeBytes;
+    std::size_t indexBytes;
+    std::size_t totalBytes;
+    double bytesPerVertex;
+    double bytesPerEdge;
+};
+
+/// -------- COMPONENTS --------
+/* Condensation of a Graph: every strongly connected component becomes a
+vertex of a DAG. The vertices of component c are
+vertices[vertexOffsets[c]] .. vertices[vertexOffsets[c + 1] - 1] and its
+successors are successors[edgeOffsets[c]] .. successors[edgeOffsets[c + 1] - 1],
+each one once. Components are numbered in topological order, so every
+edge goes from a lower component to a higher one. */
+struct Condensation {
+    VertexId numComponents;
+    std::vector<VertexId> component;
+    std::vector<std::size_t> vertexOffsets;
+    std::vector<VertexId> vertices;
+    std::vector<std::size_t> edgeOffsets;
+    std::vector<VertexId> successors;
+};
+
+/// -------- KEYS AND WEIGHTS --------
+/* How vertex keys are indexed and read back from text. Keys are indexed by
+value, except strings, which are indexed by a view of the label kept in
+the vertex so they aren't stored twice. Keys are written with <<. */
+template <class Key>
+struct KeyTraits {
+    typedef Key View;
+
+    static Key parse(const std::string& text) {
+        std::istringstream in(text);
+        Key key;
+        if(!(in >> key)){
+            throw GraphException("getFromFile: the file is corrupted.");
+        }
+        return key;
+    }
+};
+
+template <>
+struct KeyTraits<std::string> {
+    typedef std::string_view View;
+
+    static const std::string& parse(const std::string& text) {
+        return text;
+    }
+};
+
+/* Value is the weight the algorithms see, 1 on every edge of Unweighted
+graphs, and Cost is the type shortest routes add the weights up in.
+Integral weights can be frozen into a CsrGraph, which keeps them as int. */
+template <class Weight>
+struct WeightTraits {
+    static constexpr bool hasWeights = true;
+    static constexpr bool isFreezable = std::is_integral<Weight>::value;
+    static constexpr bool fitsInInt = isFreezable && std::numeric_limits<Weight>::digits <= std::numeric_limits<int>::digits;
+    typedef Weight Value;
+    typedef typename std::conditional<std::is_floating_point<Weight>::value, double, long long>::type Cost;
+};
+
+template <>
+struct WeightTraits<Unweighted> {
+    static constexpr bool hasWeights = false;
+    static constexpr bool isFreezable = true;
+    static constexpr bool fitsInInt = true;
+    typedef int Value;
+    typedef long long Cost;
+};
+
+/// -------- DIRECTION CHANGES --------
+/* Weight kept by both edges when an undirected Graph is made from a pair
+of opposite edges with different weights. First keeps the weight of the
+edge whose origin comes first in the vertex list, the others keep the
+lowest, the highest or the sum of both. A single edge always gives its
+weight to the new reverse edge. An integral sum that doesn't fit in the
+weight type throws a GraphException and leaves the Graph unchanged. */
+enum class WeightMergePolicy { First, Min, Max, Sum };
+
+/// -------- BATCHED MUTATIONS --------
+enum class MutationType { InsertEdge, DeleteEdge, EditEdge };
+
+/* One edge change for Graph::applyBatch. The weight is only used by
+inserts and edits. */
+template <class Key, class Weight>
+struct BasicMutation {
+    MutationType type;
+    Key origin;
+    Key destination;
+    Weight weight;
+};
+
+typedef BasicMutation<std::string, int> Mutation;
+
+/* A mutation of the batch that couldn't be applied, with the message
+the single call would have thrown. */
+struct MutationError {
+    std::size_t index;
+    std::string message;
+};
+
+template <class Key, class Weight> class BasicGraphBuilder;
+
 /// -------- GRAPH PROTOTYPE --------
-class Graph{
+/* Graph with vertices identified by a Key and edges weighing a Weight.
+Any Key that can be hashed, compared and written with << works; Weight
+has to be an arithmetic type or Unweighted, whose edges keep no weight
+and whose Graphs are always unweighted. Key can't be VertexId, since the
+methods taking keys would clash with the ones taking ids. Graph is the
+original string/int version and the definitions live in graph.tpp. */
+template <class Key, class Weight>
+class BasicGraph{
+    static_assert(!std::is_same<Key, VertexId>::value, "BasicGraph: Key can't be VertexId.");
+
+    friend class BasicGraphBuilder<Key, Weight>;
+
+public:
+    typedef BasicVertex<Key, Weight> Vertex;
+    typedef BasicEdge<Key, Weight> Edge;
+    typedef typename Vertex::InEdge InEdge;
+    typedef BasicMutation<Key, Weight> Mutation;
+    typedef typename WeightTraits<Weight>::Value Value;
+    typedef typename WeightTraits<Weight>::Cost Cost;
+    typedef BasicWeightedEdge<Value> WeightedEdge;
+    typedef BasicShortestPath<Cost> ShortestPath;
+    typedef std::function<Cost(const VertexId&)> RouteHeuristic;
+
 private:
+    typedef typename KeyTraits<Key>::View KeyView;
+
     Vertex* anchor;
+    Vertex* lastVertex;
+
+    /* Index from label to vertex, kept up to date by every method that
+    adds, removes or renames vertices so findVertex doesn't walk the list.
+    Keys view the label of their own vertex, so labels aren't stored twice. */
+    std::unordered_map<KeyView, Vertex*> vertexIndex;
+
+    /* Interning table from id to vertex. Ids are always dense: when a
+    vertex is deleted the vertex with the highest id takes its id. */
+    std::vector<Vertex*> vertexById;
+
+    /* Every Vertex and Edge lives in these pools. */
+    NodePool<Vertex> vertexPool;
+    NodePool<Edge> edgePool;
 
     bool isDirected;
     bool isWeighted;
+    int hubThreshold;
+    bool trackInEdges;
 
-    std::string getRoute(std::stack <std::pair <std::string, std::string>>&, const std::string&);
-    int getNumVertices();
+    /* Union-find over vertex ids for connected/componentId. Inserted
+    edges join their components right away, deletions only mark it
+    dirty and it's rebuilt by the next query. */
+    bool trackConnectivity;
+    bool connectivityDirty;
+    std::vector<VertexId> componentParent;
+
+    /* Empty unless DINAMIC_GRAPH_METRICS is defined, see graphstats.h.
+    Copies, moves and swaps don't take the metrics along. */
+    GraphMetrics metrics;
+
+    /* Off unless a capacity or a hop index is set. Copies don't take the
+    cache along, moves and swaps do. */
+    QueryCache queryCache;
+
+    std::string getRoute(const std::vector<VertexId>&);
+    ShortestPath shortestRoute(const VertexId&, const VertexId&, const RouteHeuristic*);
+    std::vector<VertexId> findBreadthFirstRoute(const VertexId&, const VertexId&, QueryContext&, GraphMetrics&);
+    std::vector<VertexId> findDepthFirstRoute(const VertexId&, const VertexId&, QueryContext&, GraphMetrics&);
+    std::vector<std::vector<VertexId>> findRoutes(const std::vector<RouteQuery>&, const unsigned&, const bool&);
+    std::vector<VertexId> findKHopNeighbourhood(const VertexId&, const unsigned&, QueryContext&, std::size_t&);
+    std::vector<VertexId> cachedBreadthFirstRoute(const VertexId&, const VertexId&, QueryContext&);
     int getNumEdges(Vertex*);
-    void copyGraph(const Graph&);
+    Edge* findEdge(Vertex*, Vertex*);
+    Edge* findPrevEdge(Vertex*, Edge*);
+    void appendEdge(Vertex*, Edge*);
+    void removeEdge(Vertex*, Edge*);
+    void updateNeighbourIndex(Vertex*);
+    void addInEdge(Vertex*, Edge*);
+    void removeInEdge(Edge*);
+    VertexId findComponent(VertexId);
+    void joinComponents(const VertexId&, const VertexId&);
+    void rebuildConnectivity();
+    void copyGraph(const BasicGraph&);
+
+    /* Weight of an edge as the algorithms see it. */
+    static Value getValue(Edge*);
 
 public:
-    Graph();
-    Graph(const Graph&);
-    ~Graph();
+    BasicGraph();
+    BasicGraph(const BasicGraph&);
+    BasicGraph(BasicGraph&&) noexcept;
+    ~BasicGraph();
 
-    Graph& operator = (const Graph&);
+    /* Copies keep the vertex ids and the order of every list. Moves and
+    swaps only exchange pointers, so they take constant time. */
+    BasicGraph& operator = (const BasicGraph&);
+    BasicGraph& operator = (BasicGraph&&) noexcept;
+    void swap(BasicGraph&) noexcept;
 
     bool isEmpty();
 
     /* Set of functions that allow the Graph to be any combination
     of directed/undirected and weighted/unweighted type. When the
     changes are made the Graph has to be adjusted and therefore
-    some weights could be overwritten. */
+    some weights could be overwritten, see WeightMergePolicy. Graphs
+    of Unweighted edges throw a GraphException if made weighted. */
     bool getIsDirected();
     bool getIsWeighted();
-    void setIsDirected(const bool&);
+    void setIsDirected(const bool&, const WeightMergePolicy& = WeightMergePolicy::First);
     void setIsWeighted(const bool&);
     std::string getGraphType();
 
-    void insertVertex(const std::string&);
-    void deleteVertex(const std::string&);
-    void editVertex(const std::string&, const std::string&);
-    Vertex* findVertex(const std::string&);
+    void insertVertex(const Key&);
+    void deleteVertex(const Key&);
+    void editVertex(const Key&, const Key&);
+    Vertex* findVertex(const Key&);
+    Vertex* findVertex(const VertexId&);
+
+    /* Every vertex has an id in the range [0, getNumVertices()). */
+    int getNumVertices();
+    VertexId getVertexId(const Key&);
+    Key getVertexLabel(const VertexId&);
 
     /* When working with an unweighted graph, the weight is automatically
     set to 1 and ignored*/
-    void insertEdge(const std::string&, const std::string&, const int&);
-    void deleteEdge(const std::string&, const std::string&);
-    void editEdge(const std::string&, const std::string&, const int&);
-    bool existsEdge(const std::string&, const std::string&);
+    void insertEdge(const Key&, const Key&, const Weight&);
+    void deleteEdge(const Key&, const Key&);
+    void editEdge(const Key&, const Key&, const Weight&);
+    bool existsEdge(const Key&, const Key&);
+
+    /* Applies a batch of edge changes as if insertEdge, deleteEdge and
+    editEdge were called in order, but grouped by origin so each group
+    looks its edges up in one pass. A failed change doesn't stop the
+    batch, it's returned with its index. On undirected Graphs the order
+    of the edges inside an adjacency list may differ from the single
+    calls. */
+    std::vector<MutationError> applyBatch(const std::vector<Mutation>&);
 
-    /* Return the Graph in a single string to be printed out. */
+    /* Vertices with more edges than the hub threshold keep a hash of
+    their neighbours, so existsEdge, editEdge and deleteEdge don't scan
+    their edge list. The default threshold is 64. */
+    void setHubThreshold(const int&);
+    int getHubThreshold();
+    int getOutDegree(const Key&);
+
+    /* When in-edges are tracked every vertex also keeps the edges that
+    point to it, so deleteVertex only visits its real predecessors and
+    getInDegree/getPredecessors don't scan the Graph. It's off by default
+    and turning it on builds the lists for the current edges.
+    Predecessors are returned in no particular order. */
+    void setTrackInEdges(const bool&);
+    bool getTrackInEdges();
+    int getInDegree(const Key&);
+    std::vector<Key> getPredecessors(const Key&);
+    std::vector<VertexId> getPredecessors(const VertexId&);
+
+    /* Connectivity queries, following edges in both directions on directed
+    Graphs. When tracked they take near constant time: inserts keep the
+    index up to date and the first query after a deletion rebuilds it.
+    Otherwise every query rebuilds it. The component id is the id of one
+    of its vertices and may change after any update. */
+    void setTrackConnectivity(const bool&);
+    bool getTrackConnectivity();
+    bool connected(const Key&, const Key&);
+    bool connected(const VertexId&, const VertexId&);
+    VertexId componentId(const Key&);
+    VertexId componentId(const VertexId&);
+
+    /* Return the Graph in a single string to be printed out, or write
+    it to a stream without building the string. */
     std::string toString();
+    void toString(std::ostream&);
 
     /* Pair of functions that allows the Graph to be kept on a
     single file. The name of the file is the only parameter. */
@@ -74,15 +320,138 @@ public:
     bool getFromFile(const std::string&);
 
     /* Set of methods returning a string of traverses or routes. */
-    std::string breadthFirstTraverse(const std::string&);
-    std::string depthFirstTraverse(const std::string&);
-    std::string breadthFirstRoute(const std::string&, const std::string&);
-    std::string depthFirstRoute(const std::string&, const std::string&);
+    std::string breadthFirstTraverse(const Key&);
+    std::string depthFirstTraverse(const Key&);
+    std::string breadthFirstRoute(const Key&, const Key&);
+    std::string depthFirstRoute(const Key&, const Key&);
+    std::string bidirectionalRoute(const Key&, const Key&);
+
+    /* Same traverses and routes working with vertex ids. Routes are
+    returned from origin to destination and are empty when there is no
+    connection. The string versions above are wrappers over these. */
+    std::vector<VertexId> breadthFirstTraverse(const VertexId&);
+    std::vector<VertexId> depthFirstTraverse(const VertexId&);
+
+    /* Traverses that hand every vertex to a visitor, in the same order,
+    as soon as it is reached. The visitor returns false to stop. */
+    void breadthFirstVisit(const VertexId&, const TraverseVisitor&);
+    void depthFirstVisit(const VertexId&, const TraverseVisitor&);
+
+    /* Traverses writing the ids to an output iterator. */
+    template <class OutputIt>
+    OutputIt breadthFirstTraverse(const VertexId& origin, OutputIt out) {
+        breadthFirstVisit(origin, [&out](const VertexId& v) {
+            *out++ = v;
+            return true;
+        });
+        return out;
+    }
+
+    template <class OutputIt>
+    OutputIt depthFirstTraverse(const VertexId& origin, OutputIt out) {
+        depthFirstVisit(origin, [&out](const VertexId& v) {
+            *out++ = v;
+            return true;
+        });
+        return out;
+    }
+    std::vector<VertexId> breadthFirstRoute(const VertexId&, const VertexId&);
+    std::vector<VertexId> depthFirstRoute(const VertexId&, const VertexId&);
+
+    /* Same routes reusing the buffers of a QueryContext, so running many
+    of them doesn't allocate or clear per-vertex arrays on every call. */
+    std::vector<VertexId> breadthFirstRoute(const VertexId&, const VertexId&, QueryContext&);
+    std::vector<VertexId> depthFirstRoute(const VertexId&, const VertexId&, QueryContext&);
+
+    /* Routes of a whole batch of queries, in the same order, shared among
+    several threads (0 uses every hardware thread), each with its own
+    QueryContext. The Graph must not change until they return. Every id
+    is checked before any route is searched. */
+    std::vector<std::vector<VertexId>> breadthFirstRoutes(const std::vector<RouteQuery>&, const unsigned& numThreads = 0);
+    std::vector<std::vector<VertexId>> depthFirstRoutes(const std::vector<RouteQuery>&, const unsigned& numThreads = 0);
+
+    /* Breadth-first route searched from both ends at once, always growing
+    the side with the smaller frontier, so it usually reaches far fewer
+    vertices than breadthFirstRoute. The destination side follows edges
+    backwards, which on directed Graphs needs the in-edges: without them
+    only the origin side grows, like a plain breadth-first search. Either
+    way the route always has the fewest edges possible, which isn't true
+    of breadthFirstRoute. */
+    std::vector<VertexId> bidirectionalRoute(const VertexId&, const VertexId&);
+
+    /* This method generates a minimum spanning tree using Prim's Algorithm,
+    taking every edge of an unweighted graph as 1 */
+    BasicGraph primSpanningTree(const Key&);
+    std::vector<WeightedEdge> primSpanningTree(const VertexId&);
+
+    /* Minimum spanning forest of the whole Graph, see CsrGraph. Weights
+    that don't fit in an int are handled here by Kruskal's algorithm. */
+    std::vector<WeightedEdge> minimumSpanningForest(const unsigned& numThreads = 0);
+
+    /* Weighted shortest routes, stopping as soon as the destination is
+    reached. Unweighted graphs count every edge as 1 and a negative weight
+    throws a GraphException. The A* heuristic gets a vertex id and must not
+    overestimate the cost left to the destination. */
+    ShortestPath dijkstraRoute(const Key&, const Key&);
+    ShortestPath dijkstraRoute(const VertexId&, const VertexId&);
+    ShortestPath aStarRoute(const Key&, const Key&, const RouteHeuristic&);
+    ShortestPath aStarRoute(const VertexId&, const VertexId&, const RouteHeuristic&);
+
+    /* Vertices at most k edges away from a vertex, itself included, in
+    breadth-first order. */
+    std::vector<VertexId> kHopNeighbourhood(const VertexId&, const unsigned& k);
 
-    /* This method generates a minimum spanning tree using Prim's Algorithm */
-    Graph primSpanningTree(const std::string&);
+    /* Cache of kHopNeighbourhood and of the single id breadthFirstRoute
+    (not the batches) keeping up to capacity results, the least recently
+    used one leaving first. 0, the default, turns it off. A cached result
+    is dropped when the edges of a vertex it looked at change; deleting a
+    vertex, which moves an id, drops them all, the hop index too. The hop
+    index keeps the k-hop neighbourhoods of the numVertices vertices with
+    most edges apart from the cache, refreshing them when they go stale;
+    building it again replaces it and 0 vertices removes it. Hits and
+    misses are counted in stats(). */
+    void setQueryCacheCapacity(const std::size_t&);
+    std::size_t getQueryCacheCapacity();
+    void buildHopIndex(const unsigned& k, const std::size_t& numVertices);
+
+    /* Structure of directed Graphs, in O(V + E) and without recursion, so
+    deep Graphs can't overflow the stack. stronglyConnectedComponents
+    returns the component of every vertex (Tarjan's algorithm), numbered
+    as in the Condensation. topologicalOrder returns every vertex after
+    all its predecessors, or nothing when there is a cycle. On undirected
+    Graphs every edge goes both ways, so the components are the connected
+    ones and only Graphs without edges have an order. */
+    std::vector<VertexId> stronglyConnectedComponents();
+    Condensation condensation();
+    std::vector<VertexId> topologicalOrder();
+    bool isAcyclic();
+
+    /* Returns an immutable compressed sparse row copy of the Graph.
+    It keeps the vertex ids and the order of every adjacency list.
+    Only Graphs with integral or Unweighted weights can be frozen, the
+    others throw a GraphException, and so does a weight that doesn't fit
+    in an int. */
+    CsrGraph freeze();
+
+    GraphMemoryUsage getMemoryUsage();
+
+    /* Counters and latency histograms gathered since the Graph was made
+    or resetStats() was called. All zero unless built with metrics. */
+    GraphStats stats();
+    void resetStats();
 
     void deleteAll();
 };
 
+template <class Key, class Weight>
+inline void swap(BasicGraph<Key, Weight>& a, BasicGraph<Key, Weight>& b) noexcept {
+    a.swap(b);
+}
+
+typedef BasicGraph<std::string, int> Graph;
+
+#include "graph.tpp"
+
+extern template class BasicGraph<std::string, int>;
+
 #endif // GRAPH_H_INCLUDED
@@ -0,0 +1,2281 @@
+#ifndef GRAPH_TPP_INCLUDED
+#define GRAPH_TPP_INCLUDED
+
+/* Definitions of BasicGraph, included at the end of graph.h. */
+
+#include <fstream>
+#include <sstream>
+#include <iterator>
+#include <queue>
+#include <utility>
+#include <tuple>
+#include <algorithm>
+#include <limits>
+#include <atomic>
+#include <thread>
+#include "graphbuilder.h"
+#include "filereader.h"
+#include "dheap.h"
+
+/// --- PRIVATE METHODS ---
+template <class Key, class Weight>
+typename BasicGraph<Key, Weight>::Value BasicGraph<Key, Weight>::getValue(Edge* e) {
+    if constexpr(WeightTraits<Weight>::hasWeights){
+        return e->getWeight();
+    }
+    else{
+        return 1;
+    }
+}
+
+template <class Key, class Weight>
+std::string BasicGraph<Key, Weight>::getRoute(const std::vector<VertexId>& route) {
+    std::string result;
+
+    if(route.size() > 1){
+        std::ostringstream routeText;
+        for(std::vector<VertexId>::const_reverse_iterator it(route.rbegin()); it != route.rend(); it++){
+            routeText << vertexById[*it]->getLabel() << " <- ";
+        }
+        result = routeText.str();
+        result = result.substr(0, result.length() - 3);
+    }
+
+    return result;
+}
+
+/* Dijkstra's algorithm, or A* when there is a heuristic. A vertex whose
+cost improves after it left the heap goes back in, so a heuristic that
+isn't consistent still gives the shortest route. */
+template <class Key, class Weight>
+typename BasicGraph<Key, Weight>::ShortestPath BasicGraph<Key, Weight>::shortestRoute(const VertexId& origin, const VertexId& destination, const RouteHeuristic* heuristic) {
+    GraphMetrics::Timer timer(metrics, GraphOperation::ShortestRoute);
+    if(origin >= vertexById.size() || destination >= vertexById.size()){
+        throw GraphException("shortestRoute: at least one of the vertices doesn't exists.");
+    }
+
+    const Cost infinite(std::numeric_limits<Cost>::max());
+    std::vector <Cost> cost(vertexById.size(), infinite);
+    std::vector <VertexId> parent(vertexById.size());
+    DaryHeap <Cost> myHeap(vertexById.size());
+    ShortestPath result;
+    result.cost = 0;
+
+    cost[origin] = 0;
+    metrics.count(GraphCounter::Traversals);
+    metrics.count(GraphCounter::FrontierVertices);
+    myHeap.push(origin, heuristic == nullptr ? 0 : (*heuristic)(origin));
+    while(!myHeap.isEmpty()){
+        VertexId currentVertex(myHeap.pop());
+
+        if(currentVertex == destination){
+            result.cost = cost[destination];
+            result.vertices.push_back(destination);
+            while(result.vertices.back() != origin){
+                result.vertices.push_back(parent[result.vertices.back()]);
+            }
+            std::reverse(result.vertices.begin(), result.vertices.end());
+            return result;
+        }
+
+        Edge* aux(vertexById[currentVertex]->getFirstEdge());
+        metrics.count(GraphCounter::EdgesScanned, vertexById[currentVertex]->getDegree());
+        while(aux != nullptr){
+            Cost weight(isWeighted ? Cost(getValue(aux)) : Cost(1));
+            if(weight < 0){
+                throw GraphException("shortestRoute: negative weights are not allowed.");
+            }
+
+            VertexId dest(aux->getDestVertex()->getId());
+            if(cost[currentVertex] + weight < cost[dest]){
+                cost[dest] = cost[currentVertex] + weight;
+                parent[dest] = currentVertex;
+                myHeap.push(dest, heuristic == nullptr ? cost[dest] : cost[dest] + (*heuristic)(dest));
+                metrics.count(GraphCounter::FrontierVertices);
+            }
+            aux = aux->getNextEdge();
+        }
+        metrics.peak(GraphCounter::FrontierPeak, myHeap.size());
+    }
+
+    return result;
+}
+
+template <class Key, class Weight>
+int BasicGraph<Key, Weight>::getNumVertices(){
+    return vertexIndex.size();
+}
+
+template <class Key, class Weight>
+int BasicGraph<Key, Weight>::getNumEdges(Vertex* v){
+    return v->getDegree();
+}
+
+template <class Key, class Weight>
+typename BasicGraph<Key, Weight>::Edge* BasicGraph<Key, Weight>::findEdge(Vertex* origin, Vertex* destination) {
+    std::unordered_map <Vertex*, Edge*>* index(origin->getNeighbourIndex());
+    metrics.count(GraphCounter::EdgeLookups);
+    if(index != nullptr){
+        metrics.count(GraphCounter::HubLookups);
+        typename std::unordered_map <Vertex*, Edge*>::const_iterator it(index->find(destination));
+        if(it == index->end()){
+            return nullptr;
+        }
+        return it->second == nullptr ? origin->getFirstEdge() : it->second->getNextEdge();
+    }
+
+    Edge* aux(origin->getFirstEdge());
+    while(aux != nullptr && aux->getDestVertex() != destination){
+        metrics.count(GraphCounter::EdgesScanned);
+        aux = aux->getNextEdge();
+    }
+    return aux;
+}
+
+/* Edges only link forward, so the one before is read from the hub index
+or found by scanning a list that is never longer than the hub threshold. */
+template <class Key, class Weight>
+typename BasicGraph<Key, Weight>::Edge* BasicGraph<Key, Weight>::findPrevEdge(Vertex* origin, Edge* e) {
+    std::unordered_map <Vertex*, Edge*>* index(origin->getNeighbourIndex());
+    if(index != nullptr){
+        return index->find(e->getDestVertex())->second;
+    }
+
+    Edge* prev(nullptr);
+    for(Edge* aux(origin->getFirstEdge()); aux != e; aux = aux->getNextEdge()){
+        metrics.count(GraphCounter::EdgesScanned);
+        prev = aux;
+    }
+    return prev;
+}
+
+template <class Key, class Weight>
+void BasicGraph<Key, Weight>::appendEdge(Vertex* origin, Edge* e) {
+    Edge* last(origin->getLastEdge());
+
+    e->setNextEdge(nullptr);
+    if(last == nullptr){
+        origin->setFirstEdge(e);
+    }
+    else{
+        last->setNextEdge(e);
+    }
+    origin->setLastEdge(e);
+    origin->setDegree(origin->getDegree() + 1);
+    metrics.count(GraphCounter::EdgeAllocations);
+    queryCache.touch(origin->getId());
+
+    if(origin->getNeighbourIndex() != nullptr){
+        origin->getNeighbourIndex()->emplace(e->getDestVertex(), last);
+    }
+    else if(origin->getDegree() > hubThreshold){
+        updateNeighbourIndex(origin);
+    }
+
+    if(trackInEdges){
+        addInEdge(origin, e);
+    }
+
+    if(trackConnectivity && !connectivityDirty){
+        joinComponents(origin->getId(), e->getDestVertex()->getId());
+    }
+}
+
+template <class Key, class Weight>
+void BasicGraph<Key, Weight>::removeEdge(Vertex* origin, Edge* e) {
+    Edge* prev(findPrevEdge(origin, e));
+    std::unordered_map <Vertex*, Edge*>* index(origin->getNeighbourIndex());
+
+    if(prev == nullptr){
+        origin->setFirstEdge(e->getNextEdge());
+    }
+    else{
+        prev->setNextEdge(e->getNextEdge());
+    }
+    if(e->getNextEdge() == nullptr){
+        origin->setLastEdge(prev);
+    }
+    else if(index != nullptr){
+        (*index)[e->getNextEdge()->getDestVertex()] = prev;
+    }
+    origin->setDegree(origin->getDegree() - 1);
+    queryCache.touch(origin->getId());
+
+    if(index != nullptr){
+        index->erase(e->getDestVertex());
+        if(origin->getDegree() < hubThreshold / 2){
+            updateNeighbourIndex(origin);
+        }
+    }
+
+    if(trackInEdges){
+        removeInEdge(e);
+    }
+    connectivityDirty = true;
+
+    edgePool.destroy(e);
+}
+
+template <class Key, class Weight>
+void BasicGraph<Key, Weight>::addInEdge(Vertex* origin, Edge* e) {
+    std::vector <InEdge>& inEdges(e->getDestVertex()->getInEdges());
+
+    e->setInIndex(inEdges.size());
+    inEdges.push_back(InEdge{origin, e});
+}
+
+template <class Key, class Weight>
+void BasicGraph<Key, Weight>::removeInEdge(Edge* e) {
+    std::vector <InEdge>& inEdges(e->getDestVertex()->getInEdges());
+
+    inEdges[e->getInIndex()] = inEdges.back();
+    inEdges[e->getInIndex()].edge->setInIndex(e->getInIndex());
+    inEdges.pop_back();
+    e->setInIndex(-1);
+}
+
+/* Vertices added since the last rebuild start as their own component. */
+template <class Key, class Weight>
+VertexId BasicGraph<Key, Weight>::findComponent(VertexId v) {
+    while(componentParent.size() < vertexById.size()){
+        componentParent.push_back(componentParent.size());
+    }
+
+    while(componentParent[v] != v){
+        componentParent[v] = componentParent[componentParent[v]];
+        v = componentParent[v];
+    }
+    return v;
+}
+
+template <class Key, class Weight>
+void BasicGraph<Key, Weight>::joinComponents(const VertexId& a, const VertexId& b) {
+    VertexId rootA(findComponent(a));
+    VertexId rootB(findComponent(b));
+
+    if(rootA < rootB){
+        componentParent[rootB] = rootA;
+    }
+    else if(rootB < rootA){
+        componentParent[rootA] = rootB;
+    }
+}
+
+template <class Key, class Weight>
+void BasicGraph<Key, Weight>::rebuildConnectivity() {
+    componentParent.clear();
+    connectivityDirty = false;
+
+    for(typename std::vector<Vertex*>::const_iterator it(vertexById.begin()); it != vertexById.end(); it++){
+        Edge* aux((*it)->getFirstEdge());
+        while(aux != nullptr){
+            joinComponents((*it)->getId(), aux->getDestVertex()->getId());
+            aux = aux->getNextEdge();
+        }
+    }
+}
+
+/* A vertex gets its neighbour index when its degree goes over the threshold
+and loses it when it falls under half of it, so a vertex near the threshold
+doesn't build and drop it on every change. */
+template <class Key, class Weight>
+void BasicGraph<Key, Weight>::updateNeighbourIndex(Vertex* v) {
+    std::unordered_map <Vertex*, Edge*>* index(v->getNeighbourIndex());
+
+    if(index == nullptr && v->getDegree() > hubThreshold){
+        index = new std::unordered_map <Vertex*, Edge*>;
+        index->reserve(v->getDegree() * 2);
+
+        Edge* prev(nullptr);
+        Edge* aux(v->getFirstEdge());
+        while(aux != nullptr){
+            index->emplace(aux->getDestVertex(), prev);
+            prev = aux;
+            aux = aux->getNextEdge();
+        }
+        v->setNeighbourIndex(index);
+    }
+    else if(index != nullptr && v->getDegree() < hubThreshold / 2){
+        delete index;
+        v->setNeighbourIndex(nullptr);
+    }
+}
+
+/* Both pools are cloned slab by slab, so every node gets a twin at the
+same place of the new slabs and each pointer is mapped to its twin
+without looking anything up. Nodes are visited in memory order. */
+template <class Key, class Weight>
+void BasicGraph<Key, Weight>::copyGraph(const BasicGraph& g){
+    GraphMetrics::Timer timer(metrics, GraphOperation::Copy);
+    deleteAll();
+
+    isDirected = g.isDirected;
+    isWeighted = g.isWeighted;
+    hubThreshold = g.hubThreshold;
+    trackInEdges = g.trackInEdges;
+    trackConnectivity = g.trackConnectivity;
+    connectivityDirty = g.connectivityDirty;
+    componentParent = g.componentParent;
+
+    typename NodePool<Vertex>::Twins vertexTwin(vertexPool.cloneLayout(g.vertexPool));
+    typename NodePool<Edge>::Twins edgeTwin(edgePool.cloneLayout(g.edgePool));
+
+    g.edgePool.forEachNode([&](Edge* e) {
+        Edge* aux = new (edgeTwin(e)) Edge(e->getWeight());
+        aux->setNextEdge(edgeTwin(e->getNextEdge()));
+        aux->setDestVertex(vertexTwin(e->getDestVertex()));
+        aux->setInIndex(e->getInIndex());
+    });
+
+    vertexIndex.reserve(g.vertexIndex.size());
+    vertexById.resize(g.vertexById.size());
+    g.vertexPool.forEachNode([&](Vertex* v) {
+        Vertex* aux = new (vertexTwin(v)) Vertex(v->getLabel());
+        aux->setId(v->getId());
+        aux->setNextVertex(vertexTwin(v->getNextVertex()));
+        aux->setPrevVertex(vertexTwin(v->getPrevVertex()));
+        aux->setFirstEdge(edgeTwin(v->getFirstEdge()));
+        aux->setLastEdge(edgeTwin(v->getLastEdge()));
+        aux->setDegree(v->getDegree());
+
+        std::vector <InEdge>& inEdges(v->getInEdges());
+        aux->getInEdges().reserve(inEdges.size());
+        for(typename std::vector<InEdge>::const_iterator it(inEdges.begin()); it != inEdges.end(); it++){
+            aux->getInEdges().push_back(InEdge{vertexTwin(it->origin), edgeTwin(it->edge)});
+        }
+
+        if(v->getNeighbourIndex() != nullptr){
+            std::unordered_map <Vertex*, Edge*>* index(new std::unordered_map <Vertex*, Edge*>);
+            index->reserve(aux->getDegree() * 2);
+            Edge* prev(nullptr);
+            for(Edge* e(aux->getFirstEdge()); e != nullptr; e = e->getNextEdge()){
+                index->emplace(e->getDestVertex(), prev);
+                prev = e;
+            }
+            aux->setNeighbourIndex(index);
+        }
+
+        vertexById[aux->getId()] = aux;
+        vertexIndex.emplace(aux->getLabel(), aux);
+    });
+
+    anchor = vertexTwin(g.anchor);
+    lastVertex = vertexTwin(g.lastVertex);
+}
+
+/// --- PUBLIC METHODS ---
+template <class Key, class Weight>
+BasicGraph<Key, Weight>::BasicGraph() : anchor(nullptr), lastVertex(nullptr), isDirected(true), isWeighted(WeightTraits<Weight>::hasWeights), hubThreshold(64), trackInEdges(false),
+    trackConnectivity(false), connectivityDirty(false) {}
+
+template <class Key, class Weight>
+BasicGraph<Key, Weight>::BasicGraph(const BasicGraph& g) : BasicGraph() {
+    copyGraph(g);
+}
+
+template <class Key, class Weight>
+BasicGraph<Key, Weight>::BasicGraph(BasicGraph&& g) noexcept : BasicGraph() {
+    swap(g);
+}
+
+template <class Key, class Weight>
+BasicGraph<Key, Weight>::~BasicGraph() {
+    deleteAll();
+}
+
+template <class Key, class Weight>
+BasicGraph<Key, Weight>& BasicGraph<Key, Weight>::operator = (const BasicGraph& g){
+    if(this != &g){
+        copyGraph(g);
+    }
+    return *this;
+}
+
+/* The moved Graph is left empty. */
+template <class Key, class Weight>
+BasicGraph<Key, Weight>& BasicGraph<Key, Weight>::operator = (BasicGraph&& g) noexcept {
+    if(this != &g){
+        deleteAll();
+        swap(g);
+    }
+    return *this;
+}
+
+template <class Key, class Weight>
+void BasicGraph<Key, Weight>::swap(BasicGraph& g) noexcept {
+    std::swap(anchor, g.anchor);
+    std::swap(lastVertex, g.lastVertex);
+    vertexIndex.swap(g.vertexIndex);
+    vertexById.swap(g.vertexById);
+    vertexPool.swap(g.vertexPool);
+    edgePool.swap(g.edgePool);
+    std::swap(isDirected, g.isDirected);
+    std::swap(isWeighted, g.isWeighted);
+    std::swap(hubThreshold, g.hubThreshold);
+    std::swap(trackInEdges, g.trackInEdges);
+    std::swap(trackConnectivity, g.trackConnectivity);
+    std::swap(connectivityDirty, g.connectivityDirty);
+    componentParent.swap(g.componentParent);
+    queryCache.swap(g.queryCache);
+}
+
+template <class Key, class Weight>
+bool BasicGraph<Key, Weight>::isEmpty() {
+    return anchor == nullptr;
+}
+
+template <class Key, class Weight>
+bool BasicGraph<Key, Weight>::getIsDirected() {
+    return isDirected;
+}
+
+template <class Key, class Weight>
+bool BasicGraph<Key, Weight>::getIsWeighted() {
+    return isWeighted;
+}
+
+/* Every edge is keyed by its pair of ends and sorted, so opposite edges
+end up next to each other. Pairs with both edges get the merged weight
+and lone edges get their reverse, appended in the order the edges were
+found: vertex list order, then adjacency order. */
+template <class Key, class Weight>
+void BasicGraph<Key, Weight>::setIsDirected(const bool& b, const WeightMergePolicy& policy) {
+    if(isDirected && !b){
+        struct PairEdge {
+            VertexId low;
+            VertexId high;
+            std::size_t position;
+            Vertex* origin;
+            Edge* edge;
+        };
+
+        std::vector <std::size_t> listPosition(vertexById.size());
+        std::vector <PairEdge> pairEdges;
+        std::size_t numVer(0);
+        Vertex* verAux(anchor);
+        while(verAux != nullptr){
+            listPosition[verAux->getId()] = numVer++;
+
+            Edge* edgeAux(verAux->getFirstEdge());
+            while(edgeAux != nullptr){
+                VertexId origin(verAux->getId());
+                VertexId destination(edgeAux->getDestVertex()->getId());
+                if(origin != destination){
+                    pairEdges.push_back(PairEdge{std::min(origin, destination), std::max(origin, destination), pairEdges.size(), verAux, edgeAux});
+                }
+                edgeAux = edgeAux->getNextEdge();
+            }
+
+            verAux = verAux->getNextVertex();
+        }
+
+        std::vector <PairEdge> sortedEdges(pairEdges);
+        std::sort(sortedEdges.begin(), sortedEdges.end(), [](const PairEdge& x, const PairEdge& y) {
+            return x.low != y.low ? x.low < y.low : x.high < y.high;
+        });
+
+        /* Merged weights are only written once every pair is merged, so a
+        sum that overflows leaves the Graph as it was. */
+        struct MergedPair {
+            Edge* first;
+            Edge* second;
+            Weight weight;
+        };
+
+        std::vector <MergedPair> mergedPairs;
+        std::vector <bool> isLone(pairEdges.size(), false);
+        std::size_t i(0);
+        while(i < sortedEdges.size()){
+            if(i + 1 < sortedEdges.size() && sortedEdges[i + 1].low == sortedEdges[i].low && sortedEdges[i + 1].high == sortedEdges[i].high){
+                Edge* first(sortedEdges[i].edge);
+                Edge* second(sortedEdges[i + 1].edge);
+                if(listPosition[sortedEdges[i + 1].origin->getId()] < listPosition[sortedEdges[i].origin->getId()]){
+                    std::swap(first, second);
+                }
+
+                if constexpr(WeightTraits<Weight>::hasWeights){
+                    Weight weight(first->getWeight());
+                    if(policy == WeightMergePolicy::Min){
+                        weight = std::min(first->getWeight(), second->getWeight());
+                    }
+                    else if(policy == WeightMergePolicy::Max){
+                        weight = std::max(first->getWeight(), second->getWeight());
+                    }
+                    else if(policy == WeightMergePolicy::Sum){
+                        if constexpr(std::is_integral<Weight>::value){
+                            if(__builtin_add_overflow(first->getWeight(), second->getWeight(), &weight)){
+                                throw GraphException("setIsDirected: the sum of two weights doesn't fit in the weight type.");
+                            }
+                        }
+                        else{
+                            weight = first->getWeight() + second->getWeight();
+                        }
+                    }
+                    mergedPairs.push_back(MergedPair{first, second, weight});
+                }
+                i += 2;
+            }
+            else{
+                isLone[sortedEdges[i].position] = true;
+                i++;
+            }
+        }
+
+        for(typename std::vector<MergedPair>::const_iterator it(mergedPairs.begin()); it != mergedPairs.end(); it++){
+            it->first->setWeight(it->weight);
+            it->second->setWeight(it->weight);
+        }
+
+        for(typename std::vector<PairEdge>::const_iterator it(pairEdges.begin()); it != pairEdges.end(); it++){
+            if(isLone[it->position]){
+                Edge* aux = edgePool.create(it->edge->getWeight());
+                if(aux == nullptr){
+                    throw GraphException("setIsDirected: memory not available.");
+                }
+                aux->setDestVertex(it->origin);
+                appendEdge(it->edge->getDestVertex(), aux);
+            }
+        }
+    }
+
+    isDirected = b;
+}
+
+template <class Key, class Weight>
+void BasicGraph<Key, Weight>::setIsWeighted(const bool& b) {
+    if(b && !WeightTraits<Weight>::hasWeights){
+        throw GraphException("setIsWeighted: the edges of this graph have no weight.");
+    }
+    isWeighted = b;
+}
+
+template <class Key, class Weight>
+std::string BasicGraph<Key, Weight>::getGraphType() {
+    std::string result;
+
+    if(isDirected){
+        result += "Directed";
+    }
+    else{
+        result += "Undirected";
+    }
+
+    if(isWeighted){
+        result += " Weighted";
+    }
+    else{
+        result += " Unweighted";
+    }
+
+    return result;
+}
+
+template <class Key, class Weight>
+void BasicGraph<Key, Weight>::insertVertex(const Key& label) {
+    GraphMetrics::Timer timer(metrics, GraphOperation::InsertVertex);
+    if(findVertex(label) != nullptr){
+        throw GraphException("insertVertex: not memory available or that vertex already exists.");
+    }
+    Vertex* aux = vertexPool.create(label);
+    metrics.count(GraphCounter::VertexAllocations);
+
+    if(isEmpty()){
+        anchor = aux;
+    }
+    else{
+        lastVertex->setNextVertex(aux);
+        aux->setPrevVertex(lastVertex);
+    }
+    lastVertex = aux;
+    vertexIndex.emplace(aux->getLabel(), aux);
+
+    aux->setId(vertexById.size());
+    vertexById.push_back(aux);
+}
+
+template <class Key, class Weight>
+void BasicGraph<Key, Weight>::deleteVertex(const Key& label) {
+    GraphMetrics::Timer timer(metrics, GraphOperation::DeleteVertex);
+    Vertex* vertexToBeDeleted(findVertex(label));
+    if(vertexToBeDeleted == nullptr){
+        throw GraphException("deleteVertex: there is not such vertex.");
+    }
+
+    /* Only the edges that really point to the vertex are removed: they are
+    its in-edges when those are tracked, and the reverse of its own edges
+    on an undirected graph. Otherwise every vertex has to be checked. */
+    if(trackInEdges){
+        std::vector <InEdge>& inEdges(vertexToBeDeleted->getInEdges());
+        while(!inEdges.empty()){
+            removeEdge(inEdges.back().origin, inEdges.back().edge);
+        }
+    }
+    else if(!isDirected){
+        Edge* edgeAux(vertexToBeDeleted->getFirstEdge());
+        while(edgeAux != nullptr){
+            Vertex* neighbour(edgeAux->getDestVertex());
+            Edge* reverseEdge(neighbour == vertexToBeDeleted ? nullptr : findEdge(neighbour, vertexToBeDeleted));
+            if(reverseEdge != nullptr){
+                removeEdge(neighbour, reverseEdge);
+            }
+            edgeAux = edgeAux->getNextEdge();
+        }
+    }
+    else{
+        Vertex* verAux(anchor);
+        while(verAux != nullptr){
+            Edge* edgeAux(verAux == vertexToBeDeleted ? nullptr : findEdge(verAux, vertexToBeDeleted));
+            if(edgeAux != nullptr){
+                removeEdge(verAux, edgeAux);
+            }
+            verAux = verAux->getNextVertex();
+        }
+    }
+    while(vertexToBeDeleted->getFirstEdge() != nullptr){
+        removeEdge(vertexToBeDeleted, vertexToBeDeleted->getFirstEdge());
+    }
+    connectivityDirty = true;
+
+    Vertex* prev(vertexToBeDeleted->getPrevVertex());
+    Vertex* next(vertexToBeDeleted->getNextVertex());
+    if(prev == nullptr){
+        anchor = next;
+    }
+    else{
+        prev->setNextVertex(next);
+    }
+    if(next == nullptr){
+        lastVertex = prev;
+    }
+    else{
+        next->setPrevVertex(prev);
+    }
+
+    vertexIndex.erase(label);
+
+    Vertex* moved(vertexById.back());
+    moved->setId(vertexToBeDeleted->getId());
+    vertexById[moved->getId()] = moved;
+    vertexById.pop_back();
+    queryCache.clear();
+
+    vertexPool.destroy(vertexToBeDeleted);
+}
+
+template <class Key, class Weight>
+void BasicGraph<Key, Weight>::editVertex(const Key& oldLabel, const Key& newLabel) {
+    GraphMetrics::Timer timer(metrics, GraphOperation::EditVertex);
+    Vertex* aux(findVertex(oldLabel));
+    if(aux == nullptr || findVertex(newLabel) != nullptr){
+        throw GraphException("editVertex: there is not such vertex or new vertex already exists");
+    }
+
+    vertexIndex.erase(oldLabel);
+    aux->setLabel(newLabel);
+    vertexIndex.emplace(aux->getLabel(), aux);
+}
+
+template <class Key, class Weight>
+typename BasicGraph<Key, Weight>::Vertex* BasicGraph<Key, Weight>::findVertex(const Key& label) {
+    metrics.count(GraphCounter::VertexLookups);
+    typename std::unordered_map <KeyView, Vertex*>::const_iterator it(vertexIndex.find(label));
+    if(it == vertexIndex.end()){
+        return nullptr;
+    }
+
+    return it->second;
+}
+
+template <class Key, class Weight>
+typename BasicGraph<Key, Weight>::Vertex* BasicGraph<Key, Weight>::findVertex(const VertexId& id) {
+    if(id >= vertexById.size()){
+        return nullptr;
+    }
+
+    return vertexById[id];
+}
+
+template <class Key, class Weight>
+VertexId BasicGraph<Key, Weight>::getVertexId(const Key& label) {
+    Vertex* aux(findVertex(label));
+    if(aux == nullptr){
+        throw GraphException("getVertexId: there is not such vertex.");
+    }
+
+    return aux->getId();
+}
+
+template <class Key, class Weight>
+Key BasicGraph<Key, Weight>::getVertexLabel(const VertexId& id) {
+    if(id >= vertexById.size()){
+        throw GraphException("getVertexLabel: there is not such vertex.");
+    }
+
+    return vertexById[id]->getLabel();
+}
+
+template <class Key, class Weight>
+void BasicGraph<Key, Weight>::insertEdge(const Key& originLabel, const Key& destLabel, const Weight& weight) {
+    GraphMetrics::Timer timer(metrics, GraphOperation::InsertEdge);
+    Vertex* origin(findVertex(originLabel));
+    Vertex* destination(findVertex(destLabel));
+
+    if(origin == nullptr || destination == nullptr){
+        throw GraphException("insertEdge: at least one vertex doesn't exists.");
+    }
+    if(findEdge(origin, destination) == nullptr){
+        Edge* aux = edgePool.create(weight);
+        if(aux == nullptr){
+            throw GraphException("insertEdge: memory not available.");
+        }
+        aux->setDestVertex(destination);
+        appendEdge(origin, aux);
+
+        if(!isDirected && findEdge(destination, origin) == nullptr){
+            Edge* aux2 = edgePool.create(weight);
+            if(aux2 == nullptr){
+                throw GraphException("insertEdge: memory not available.");
+            }
+            aux2->setDestVertex(origin);
+            appendEdge(destination, aux2);
+        }
+    }
+}
+
+template <class Key, class Weight>
+void BasicGraph<Key, Weight>::deleteEdge(const Key& originLabel, const Key& destLabel) {
+    GraphMetrics::Timer timer(metrics, GraphOperation::DeleteEdge);
+    Vertex* origin(findVertex(originLabel));
+    Vertex* destination(findVertex(destLabel));
+    Edge* aux(origin == nullptr || destination == nullptr ? nullptr : findEdge(origin, destination));
+
+    if(aux == nullptr){
+        throw GraphException("deleteEdge: there is not such edge.");
+    }
+    removeEdge(origin, aux);
+
+    if(!isDirected && origin != destination){
+        Edge* aux2(findEdge(destination, origin));
+        if(aux2 != nullptr){
+            removeEdge(destination, aux2);
+        }
+    }
+}
+
+template <class Key, class Weight>
+void BasicGraph<Key, Weight>::editEdge(const Key& originLabel, const Key& destLabel, const Weight& p) {
+    GraphMetrics::Timer timer(metrics, GraphOperation::EditEdge);
+    Vertex* origin(findVertex(originLabel));
+    Vertex* destination(findVertex(destLabel));
+    Edge* aux(origin == nullptr || destination == nullptr ? nullptr : findEdge(origin, destination));
+
+    if(aux == nullptr){
+        throw GraphException("editEdge: there is not such edge.");
+    }
+    aux->setWeight(p);
+    queryCache.touch(origin->getId());
+
+    if(!isDirected){
+        Edge* aux2(findEdge(destination, origin));
+        if(aux2 != nullptr){
+            aux2->setWeight(p);
+            queryCache.touch(destination->getId());
+        }
+    }
+}
+
+template <class Key, class Weight>
+bool BasicGraph<Key, Weight>::existsEdge(const Key& originLabel, const Key& destLabel) {
+    GraphMetrics::Timer timer(metrics, GraphOperation::ExistsEdge);
+    Vertex* origin(findVertex(originLabel));
+    Vertex* destination(findVertex(destLabel));
+
+    if(origin == nullptr || destination == nullptr){
+        return false;
+    }
+
+    return findEdge(origin, destination) != nullptr;
+}
+
+/* Changes are grouped by their origin, or by the lower id of both ends
+on undirected Graphs, so a pair of vertices always lands in the same
+group and keeps its order. Groups of a vertex without a hub hash get a
+temporary one from a single pass over its edges. */
+template <class Key, class Weight>
+std::vector<MutationError> BasicGraph<Key, Weight>::applyBatch(const std::vector<Mutation>& batch) {
+    GraphMetrics::Timer timer(metrics, GraphOperation::ApplyBatch);
+    std::vector <MutationError> errors;
+    std::vector <std::pair<Vertex*, Vertex*>> ends(batch.size());
+    std::vector <std::pair<VertexId, std::size_t>> order;
+    order.reserve(batch.size());
+
+    for(std::size_t i(0); i < batch.size(); i++){
+        Vertex* origin(findVertex(batch[i].origin));
+        Vertex* destination(findVertex(batch[i].destination));
+
+        if(origin == nullptr || destination == nullptr){
+            if(batch[i].type == MutationType::InsertEdge){
+                errors.push_back(MutationError{i, "insertEdge: at least one vertex doesn't exists."});
+            }
+            else if(batch[i].type == MutationType::DeleteEdge){
+                errors.push_back(MutationError{i, "deleteEdge: there is not such edge."});
+            }
+            else{
+                errors.push_back(MutationError{i, "editEdge: there is not such edge."});
+            }
+            continue;
+        }
+
+        if(!isDirected && destination->getId() < origin->getId()){
+            std::swap(origin, destination);
+        }
+        ends[i] = std::make_pair(origin, destination);
+        order.push_back(std::make_pair(origin->getId(), i));
+    }
+
+    std::stable_sort(order.begin(), order.end(), [](const std::pair<VertexId, std::size_t>& a, const std::pair<VertexId, std::size_t>& b) {
+        return a.first < b.first;
+    });
+
+    std::unordered_map <Vertex*, Edge*> neighbours;
+    std::size_t groupStart(0);
+    while(groupStart < order.size()){
+        std::size_t groupEnd(groupStart + 1);
+        while(groupEnd < order.size() && order[groupEnd].first == order[groupStart].first){
+            groupEnd++;
+        }
+
+        Vertex* origin(vertexById[order[groupStart].first]);
+        bool useMap(groupEnd - groupStart > 1 && origin->getNeighbourIndex() == nullptr);
+        if(useMap){
+            neighbours.clear();
+            neighbours.reserve(origin->getDegree());
+            Edge* aux(origin->getFirstEdge());
+            while(aux != nullptr){
+                neighbours.emplace(aux->getDestVertex(), aux);
+                aux = aux->getNextEdge();
+            }
+        }
+
+        for(std::size_t g(groupStart); g < groupEnd; g++){
+            std::size_t i(order[g].second);
+            Vertex* destination(ends[i].second);
+            Edge* aux(nullptr);
+            if(useMap){
+                typename std::unordered_map <Vertex*, Edge*>::const_iterator it(neighbours.find(destination));
+                aux = it == neighbours.end() ? nullptr : it->second;
+            }
+            else{
+                aux = findEdge(origin, destination);
+            }
+
+            if(batch[i].type == MutationType::InsertEdge){
+                if(aux != nullptr){
+                    continue;
+                }
+                aux = edgePool.create(batch[i].weight);
+                if(aux == nullptr){
+                    errors.push_back(MutationError{i, "insertEdge: memory not available."});
+                    continue;
+                }
+                aux->setDestVertex(destination);
+                appendEdge(origin, aux);
+                if(useMap){
+                    neighbours[destination] = aux;
+                }
+
+                if(!isDirected && findEdge(destination, origin) == nullptr){
+                    Edge* aux2 = edgePool.create(batch[i].weight);
+                    if(aux2 == nullptr){
+                        errors.push_back(MutationError{i, "insertEdge: memory not available."});
+                        continue;
+                    }
+                    aux2->setDestVertex(origin);
+                    appendEdge(destination, aux2);
+                }
+            }
+            else if(batch[i].type == MutationType::DeleteEdge){
+                if(aux == nullptr){
+                    errors.push_back(MutationError{i, "deleteEdge: there is not such edge."});
+                    continue;
+                }
+                removeEdge(origin, aux);
+                if(useMap){
+                    neighbours.erase(destination);
+                }
+
+                if(!isDirected && origin != destination){
+                    Edge* aux2(findEdge(destination, origin));
+                    if(aux2 != nullptr){
+                        removeEdge(destination, aux2);
+                    }
+                }
+            }
+            else{
+                if(aux == nullptr){
+                    errors.push_back(MutationError{i, "editEdge: there is not such edge."});
+                    continue;
+                }
+                aux->setWeight(batch[i].weight);
+                queryCache.touch(origin->getId());
+
+                if(!isDirected){
+                    Edge* aux2(findEdge(destination, origin));
+                    if(aux2 != nullptr){
+                        aux2->setWeight(batch[i].weight);
+                        queryCache.touch(destination->getId());
+                    }
+                }
+            }
+        }
+
+        groupStart = groupEnd;
+    }
+
+    std::sort(errors.begin(), errors.end(), [](const MutationError& a, const MutationError& b) {
+        return a.index < b.index;
+    });
+    return errors;
+}
+
+template <class Key, class Weight>
+void BasicGraph<Key, Weight>::setHubThreshold(const int& threshold) {
+    hubThreshold = threshold;
+
+    for(typename std::vector<Vertex*>::const_iterator it(vertexById.begin()); it != vertexById.end(); it++){
+        updateNeighbourIndex(*it);
+    }
+}
+
+template <class Key, class Weight>
+int BasicGraph<Key, Weight>::getHubThreshold() {
+    return hubThreshold;
+}
+
+template <class Key, class Weight>
+void BasicGraph<Key, Weight>::setTrackInEdges(const bool& b) {
+    if(b && !trackInEdges){
+        for(typename std::vector<Vertex*>::const_iterator it(vertexById.begin()); it != vertexById.end(); it++){
+            Edge* aux((*it)->getFirstEdge());
+            while(aux != nullptr){
+                addInEdge(*it, aux);
+                aux = aux->getNextEdge();
+            }
+        }
+    }
+    else if(!b && trackInEdges){
+        for(typename std::vector<Vertex*>::const_iterator it(vertexById.begin()); it != vertexById.end(); it++){
+            std::vector<InEdge>().swap((*it)->getInEdges());
+        }
+    }
+
+    trackInEdges = b;
+}
+
+template <class Key, class Weight>
+bool BasicGraph<Key, Weight>::getTrackInEdges() {
+    return trackInEdges;
+}
+
+template <class Key, class Weight>
+void BasicGraph<Key, Weight>::setTrackConnectivity(const bool& b) {
+    trackConnectivity = b;
+
+    if(b){
+        rebuildConnectivity();
+    }
+    else{
+        std::vector<VertexId>().swap(componentParent);
+    }
+}
+
+template <class Key, class Weight>
+bool BasicGraph<Key, Weight>::getTrackConnectivity() {
+    return trackConnectivity;
+}
+
+template <class Key, class Weight>
+bool BasicGraph<Key, Weight>::connected(const Key& a, const Key& b) {
+    Vertex* auxA(findVertex(a));
+    Vertex* auxB(findVertex(b));
+    if(auxA == nullptr || auxB == nullptr){
+        throw GraphException("connected: at least one vertex doesn't exists.");
+    }
+
+    return connected(auxA->getId(), auxB->getId());
+}
+
+template <class Key, class Weight>
+bool BasicGraph<Key, Weight>::connected(const VertexId& a, const VertexId& b) {
+    if(a >= vertexById.size() || b >= vertexById.size()){
+        throw GraphException("connected: at least one vertex doesn't exists.");
+    }
+
+    if(!trackConnectivity || connectivityDirty){
+        rebuildConnectivity();
+    }
+    return findComponent(a) == findComponent(b);
+}
+
+template <class Key, class Weight>
+VertexId BasicGraph<Key, Weight>::componentId(const Key& label) {
+    Vertex* aux(findVertex(label));
+    if(aux == nullptr){
+        throw GraphException("componentId: there is not such vertex.");
+    }
+
+    return componentId(aux->getId());
+}
+
+template <class Key, class Weight>
+VertexId BasicGraph<Key, Weight>::componentId(const VertexId& id) {
+    if(id >= vertexById.size()){
+        throw GraphException("componentId: there is not such vertex.");
+    }
+
+    if(!trackConnectivity || connectivityDirty){
+        rebuildConnectivity();
+    }
+    return findComponent(id);
+}
+
+template <class Key, class Weight>
+int BasicGraph<Key, Weight>::getOutDegree(const Key& label) {
+    Vertex* aux(findVertex(label));
+    if(aux == nullptr){
+        throw GraphException("getOutDegree: there is not such vertex.");
+    }
+
+    return aux->getDegree();
+}
+
+template <class Key, class Weight>
+int BasicGraph<Key, Weight>::getInDegree(const Key& label) {
+    Vertex* aux(findVertex(label));
+    if(aux == nullptr){
+        throw GraphException("getInDegree: there is not such vertex.");
+    }
+
+    if(trackInEdges){
+        return aux->getInEdges().size();
+    }
+    return getPredecessors(aux->getId()).size();
+}
+
+template <class Key, class Weight>
+std::vector<Key> BasicGraph<Key, Weight>::getPredecessors(const Key& label) {
+    Vertex* aux(findVertex(label));
+    if(aux == nullptr){
+        throw GraphException("getPredecessors: there is not such vertex.");
+    }
+
+    std::vector <VertexId> ids(getPredecessors(aux->getId()));
+    std::vector <Key> predecessors;
+    predecessors.reserve(ids.size());
+    for(std::vector<VertexId>::const_iterator it(ids.begin()); it != ids.end(); it++){
+        predecessors.push_back(vertexById[*it]->getLabel());
+    }
+
+    return predecessors;
+}
+
+template <class Key, class Weight>
+std::vector<VertexId> BasicGraph<Key, Weight>::getPredecessors(const VertexId& id) {
+    if(id >= vertexById.size()){
+        throw GraphException("getPredecessors: there is not such vertex.");
+    }
+
+    Vertex* target(vertexById[id]);
+    std::vector <VertexId> predecessors;
+
+    if(trackInEdges){
+        std::vector <InEdge>& inEdges(target->getInEdges());
+        predecessors.reserve(inEdges.size());
+        for(typename std::vector<InEdge>::const_iterator it(inEdges.begin()); it != inEdges.end(); it++){
+            predecessors.push_back(it->origin->getId());
+        }
+    }
+    else if(!isDirected){
+        Edge* aux(target->getFirstEdge());
+        while(aux != nullptr){
+            predecessors.push_back(aux->getDestVertex()->getId());
+            aux = aux->getNextEdge();
+        }
+    }
+    else{
+        Vertex* verAux(anchor);
+        while(verAux != nullptr){
+            if(findEdge(verAux, target) != nullptr){
+                predecessors.push_back(verAux->getId());
+            }
+            verAux = verAux->getNextVertex();
+        }
+    }
+
+    return predecessors;
+}
+
+template <class Key, class Weight>
+std::string BasicGraph<Key, Weight>::toString() {
+    std::ostringstream result;
+    toString(result);
+    return result.str();
+}
+
+template <class Key, class Weight>
+void BasicGraph<Key, Weight>::toString(std::ostream& out) {
+    Vertex* verAux(anchor);
+
+    while(verAux != nullptr){
+        out << verAux->getLabel();
+
+        Edge* edgeAux(verAux->getFirstEdge());
+        while(edgeAux != nullptr){
+            out << " -> " << edgeAux->getDestVertex()->getLabel();
+            if(isWeighted){
+                out << ':' << edgeAux->getWeight();
+            }
+            edgeAux = edgeAux->getNextEdge();
+        }
+
+        verAux = verAux->getNextVertex();
+        out << '\n';
+    }
+}
+
+template <class Key, class Weight>
+void BasicGraph<Key, Weight>::saveToFile(const std::string& fileName) {
+    GraphMetrics::Timer timer(metrics, GraphOperation::SaveToFile);
+    std::ofstream myFile(fileName, std::ios::trunc);
+
+    myFile << isDirected << '|' << isWeighted << "\n";
+
+    myFile << getNumVertices() << "\n";
+    Vertex* auxVer(anchor);
+    while(auxVer != nullptr){
+        myFile << auxVer->getLabel() << "\n";
+        auxVer = auxVer->getNextVertex();
+    }
+
+    auxVer = anchor;
+    while(auxVer != nullptr){
+        myFile << getNumEdges(auxVer) << "\n";
+
+        Edge* auxAri(auxVer->getFirstEdge());
+        while(auxAri != nullptr){
+            myFile << auxVer->getLabel() << '|' << auxAri->getDestVertex()->getLabel() << '|' << auxAri->getWeight() << "\n";
+            auxAri = auxAri->getNextEdge();
+        }
+
+        auxVer = auxVer->getNextVertex();
+    }
+
+    myFile.close();
+}
+
+template <class Key, class Weight>
+bool BasicGraph<Key, Weight>::getFromFile(const std::string& fileName) {
+    GraphMetrics::Timer timer(metrics, GraphOperation::GetFromFile);
+    deleteAll();
+    FileReader myFile(fileName);
+
+    if(myFile.good()){
+        int numVer, numEdges;
+        Weight weight;
+        std::string origin, destination, text;
+        BasicGraphBuilder<Key, Weight> builder(*this);
+        const std::size_t numLines(myFile.countLines());
+
+        isDirected = myFile.readInt();
+        myFile.ignore('|');
+        isWeighted = myFile.readInt() && WeightTraits<Weight>::hasWeights;
+        myFile.ignore('\n');
+
+        numVer = myFile.readInt();
+        myFile.ignore('\n');
+        /* Every vertex takes two lines (its label and its edge count) after
+        the first two, and the last one may have no newline, so a bigger
+        count is corrupted. Every other line is an edge, and undirected
+        files hold both directions of every edge. */
+        if(numVer < 0 || 1 + 2 * std::size_t(numVer) > numLines){
+            throw GraphException("getFromFile: the file is corrupted.");
+        }
+        std::size_t numRecords(numLines - 1 - 2 * std::size_t(numVer));
+        builder.reserve(numVer, isDirected ? numRecords : numRecords / 2);
+        for(int i(0); i < numVer; i++){
+            myFile.readUntil(origin, '\n');
+            builder.addVertex(KeyTraits<Key>::parse(origin));
+        }
+
+        for(int i(0); i < numVer; i++){
+            numEdges = myFile.readInt();
+            myFile.ignore('\n');
+            if(numEdges < 0){
+                throw GraphException("getFromFile: the file is corrupted.");
+            }
+
+            for(int j(0); j < numEdges; j++){
+                myFile.readUntil(origin, '|');
+                myFile.readUntil(destination, '|');
+                if constexpr(std::is_same<Weight, int>::value){
+                    weight = myFile.readInt();
+                    myFile.ignore('\n');
+                }
+                else if constexpr(WeightTraits<Weight>::hasWeights){
+                    myFile.readUntil(text, '\n');
+                    std::istringstream in(text);
+                    if(!(in >> weight)){
+                        throw GraphException("getFromFile: the file is corrupted.");
+                    }
+                }
+                else{
+                    myFile.ignore('\n');
+                }
+
+                builder.addEdge(KeyTraits<Key>::parse(origin), KeyTraits<Key>::parse(destination), weight);
+            }
+        }
+
+        return true;
+    }
+    return false;
+}
+
+template <class Key, class Weight>
+std::string BasicGraph<Key, Weight>::breadthFirstTraverse(const Key& origin) {
+    Vertex* auxVer(findVertex(origin));
+    if(auxVer == nullptr){
+        return "There is not such origin vertex.";
+    }
+
+    std::ostringstream traverse;
+    breadthFirstVisit(auxVer->getId(), [this, &traverse](const VertexId& v) {
+        traverse << vertexById[v]->getLabel() << " -> ";
+        return true;
+    });
+
+    std::string result(traverse.str());
+    return result.substr(0, result.length() - 3);
+}
+
+template <class Key, class Weight>
+std::string BasicGraph<Key, Weight>::depthFirstTraverse(const Key& origin) {
+    Vertex* auxVer(findVertex(origin));
+    if(auxVer == nullptr){
+        return "There is not such origin vertex.";
+    }
+
+    std::ostringstream traverse;
+    depthFirstVisit(auxVer->getId(), [this, &traverse](const VertexId& v) {
+        traverse << vertexById[v]->getLabel() << " -> ";
+        return true;
+    });
+
+    std::string result(traverse.str());
+    return result.substr(0, result.length() - 3);
+}
+
+template <class Key, class Weight>
+std::string BasicGraph<Key, Weight>::breadthFirstRoute(const Key& origin, const Key& destination) {
+    Vertex* originVer(findVertex(origin));
+    Vertex* destVer(findVertex(destination));
+    if(originVer == nullptr || destVer == nullptr){
+        return "At least one of the vertices doesn't exists";
+    }
+
+    std::vector <VertexId> route(breadthFirstRoute(originVer->getId(), destVer->getId()));
+    if(route.empty()){
+        return "\nThere is no conection between those vertices\n";
+    }
+
+    return getRoute(route);
+}
+
+template <class Key, class Weight>
+std::string BasicGraph<Key, Weight>::depthFirstRoute(const Key& origin, const Key& destination) {
+    Vertex* originVer(findVertex(origin));
+    Vertex* destVer(findVertex(destination));
+    if(originVer == nullptr || destVer == nullptr){
+        return "At least one of the vertices doesn't exists";
+    }
+
+    std::vector <VertexId> route(depthFirstRoute(originVer->getId(), destVer->getId()));
+    if(route.empty()){
+        return "\nThere is no conection between those vertices\n";
+    }
+
+    return getRoute(route);
+}
+
+template <class Key, class Weight>
+std::string BasicGraph<Key, Weight>::bidirectionalRoute(const Key& origin, const Key& destination) {
+    Vertex* originVer(findVertex(origin));
+    Vertex* destVer(findVertex(destination));
+    if(originVer == nullptr || destVer == nullptr){
+        return "At least one of the vertices doesn't exists";
+    }
+
+    std::vector <VertexId> route(bidirectionalRoute(originVer->getId(), destVer->getId()));
+    if(route.empty()){
+        return "\nThere is no conection between those vertices\n";
+    }
+
+    return getRoute(route);
+}
+
+template <class Key, class Weight>
+std::vector<VertexId> BasicGraph<Key, Weight>::breadthFirstTraverse(const VertexId& origin) {
+    std::vector <VertexId> traverse;
+    breadthFirstTraverse(origin, std::back_inserter(traverse));
+    return traverse;
+}
+
+template <class Key, class Weight>
+std::vector<VertexId> BasicGraph<Key, Weight>::depthFirstTraverse(const VertexId& origin) {
+    std::vector <VertexId> traverse;
+    depthFirstTraverse(origin, std::back_inserter(traverse));
+    return traverse;
+}
+
+template <class Key, class Weight>
+void BasicGraph<Key, Weight>::breadthFirstVisit(const VertexId& origin, const TraverseVisitor& visitor) {
+    GraphMetrics::Timer timer(metrics, GraphOperation::Traverse);
+    if(origin >= vertexById.size()){
+        throw GraphException("breadthFirstTraverse: there is not such vertex.");
+    }
+
+    std::vector <bool> queued(vertexById.size(), false);
+    std::vector <VertexId> myQueue;
+    std::size_t front(0);
+
+    metrics.count(GraphCounter::Traversals);
+    metrics.count(GraphCounter::FrontierVertices);
+    myQueue.push_back(origin);
+    queued[origin] = true;
+    while(front < myQueue.size()){
+        VertexId currentVertex(myQueue[front++]);
+        if(!visitor(currentVertex)){
+            return;
+        }
+
+        Edge* aux(vertexById[currentVertex]->getFirstEdge());
+        metrics.count(GraphCounter::EdgesScanned, vertexById[currentVertex]->getDegree());
+        while(aux != nullptr){
+            VertexId dest(aux->getDestVertex()->getId());
+            if(!queued[dest]){
+                queued[dest] = true;
+                myQueue.push_back(dest);
+                metrics.count(GraphCounter::FrontierVertices);
+            }
+            aux = aux->getNextEdge();
+        }
+        metrics.peak(GraphCounter::FrontierPeak, myQueue.size() - front);
+    }
+}
+
+template <class Key, class Weight>
+void BasicGraph<Key, Weight>::depthFirstVisit(const VertexId& origin, const TraverseVisitor& visitor) {
+    GraphMetrics::Timer timer(metrics, GraphOperation::Traverse);
+    if(origin >= vertexById.size()){
+        throw GraphException("depthFirstTraverse: there is not such vertex.");
+    }
+
+    std::vector <bool> visited(vertexById.size(), false);
+    std::vector <VertexId> myStack;
+
+    metrics.count(GraphCounter::Traversals);
+    metrics.count(GraphCounter::FrontierVertices);
+    myStack.push_back(origin);
+    while(!myStack.empty()){
+        VertexId currentVertex(myStack.back());
+        myStack.pop_back();
+
+        if(!visited[currentVertex]){
+            visited[currentVertex] = true;
+            if(!visitor(currentVertex)){
+                return;
+            }
+
+            Edge* aux(vertexById[currentVertex]->getFirstEdge());
+            metrics.count(GraphCounter::EdgesScanned, vertexById[currentVertex]->getDegree());
+            while(aux != nullptr){
+                VertexId dest(aux->getDestVertex()->getId());
+                if(!visited[dest]){
+                    myStack.push_back(dest);
+                    metrics.count(GraphCounter::FrontierVertices);
+                }
+                aux = aux->getNextEdge();
+            }
+            metrics.peak(GraphCounter::FrontierPeak, myStack.size());
+        }
+    }
+}
+
+/* In both routes the parent of a vertex is the last vertex that reached it
+before it was visited, which is the route the string versions always gave.
+The ids have been checked by the caller. */
+template <class Key, class Weight>
+std::vector<VertexId> BasicGraph<Key, Weight>::findBreadthFirstRoute(const VertexId& origin, const VertexId& destination, QueryContext& context, GraphMetrics& m) {
+    GraphMetrics::Timer timer(m, GraphOperation::Route);
+    std::vector <VertexId>& parent(context.parent);
+    std::vector <VertexId>& myQueue(context.pending);
+    std::vector <VertexId> route;
+    std::size_t front(0);
+
+    context.begin(vertexById.size());
+    m.count(GraphCounter::Traversals);
+    m.count(GraphCounter::FrontierVertices);
+    myQueue.push_back(origin);
+    context.reach(origin);
+    while(front < myQueue.size()){
+        VertexId currentVertex(myQueue[front++]);
+
+        if(currentVertex == destination){
+            route.push_back(destination);
+            while(route.back() != origin){
+                route.push_back(parent[route.back()]);
+            }
+            std::reverse(route.begin(), route.end());
+            return route;
+        }
+
+        context.visit(currentVertex);
+
+        Edge* aux(vertexById[currentVertex]->getFirstEdge());
+        m.count(GraphCounter::EdgesScanned, vertexById[currentVertex]->getDegree());
+        while(aux != nullptr){
+            VertexId dest(aux->getDestVertex()->getId());
+            if(!context.isVisited(dest)){
+                parent[dest] = currentVertex;
+                if(!context.isReached(dest)){
+                    context.reach(dest);
+                    myQueue.push_back(dest);
+                    m.count(GraphCounter::FrontierVertices);
+                }
+            }
+            aux = aux->getNextEdge();
+        }
+        m.peak(GraphCounter::FrontierPeak, myQueue.size() - front);
+    }
+
+    return route;
+}
+
+template <class Key, class Weight>
+std::vector<VertexId> BasicGraph<Key, Weight>::findDepthFirstRoute(const VertexId& origin, const VertexId& destination, QueryContext& context, GraphMetrics& m) {
+    GraphMetrics::Timer timer(m, GraphOperation::Route);
+    std::vector <VertexId>& parent(context.parent);
+    std::vector <VertexId>& myStack(context.pending);
+    std::vector <VertexId> route;
+
+    context.begin(vertexById.size());
+    m.count(GraphCounter::Traversals);
+    m.count(GraphCounter::FrontierVertices);
+    myStack.push_back(origin);
+    while(!myStack.empty()){
+        VertexId currentVertex(myStack.back());
+        myStack.pop_back();
+
+        if(!context.isVisited(currentVertex)){
+            if(currentVertex == destination){
+                route.push_back(destination);
+                while(route.back() != origin){
+                    route.push_back(parent[route.back()]);
+                }
+                std::reverse(route.begin(), route.end());
+                return route;
+            }
+
+            context.visit(currentVertex);
+
+            Edge* aux(vertexById[currentVertex]->getFirstEdge());
+            m.count(GraphCounter::EdgesScanned, vertexById[currentVertex]->getDegree());
+            while(aux != nullptr){
+                VertexId dest(aux->getDestVertex()->getId());
+                if(!context.isVisited(dest)){
+                    myStack.push_back(dest);
+                    parent[dest] = currentVertex;
+                    m.count(GraphCounter::FrontierVertices);
+                }
+                aux = aux->getNextEdge();
+            }
+            m.peak(GraphCounter::FrontierPeak, myStack.size());
+        }
+    }
+
+    return route;
+}
+
+/* Expands k levels; numExpanded is set to the number of vertices whose
+edges were followed, the first ones of the result. */
+template <class Key, class Weight>
+std::vector<VertexId> BasicGraph<Key, Weight>::findKHopNeighbourhood(const VertexId& origin, const unsigned& k, QueryContext& context, std::size_t& numExpanded) {
+    GraphMetrics::Timer timer(metrics, GraphOperation::Traverse);
+    std::vector <VertexId>& myQueue(context.pending);
+    std::size_t front(0);
+
+    context.begin(vertexById.size());
+    metrics.count(GraphCounter::Traversals);
+    metrics.count(GraphCounter::FrontierVertices);
+    myQueue.push_back(origin);
+    context.reach(origin);
+    for(unsigned depth(0); depth < k && front < myQueue.size(); depth++){
+        std::size_t levelEnd(myQueue.size());
+        for(; front < levelEnd; front++){
+            Vertex* current(vertexById[myQueue[front]]);
+            metrics.count(GraphCounter::EdgesScanned, current->getDegree());
+            for(Edge* aux(current->getFirstEdge()); aux != nullptr; aux = aux->getNextEdge()){
+                VertexId dest(aux->getDestVertex()->getId());
+                if(!context.isReached(dest)){
+                    context.reach(dest);
+                    myQueue.push_back(dest);
+                    metrics.count(GraphCounter::FrontierVertices);
+                }
+            }
+        }
+        metrics.peak(GraphCounter::FrontierPeak, myQueue.size() - front);
+    }
+
+    numExpanded = front;
+    return myQueue;
+}
+
+/* The route only depends on the edges of the vertices the search
+expanded, which are the visited ones left in the context's queue. */
+template <class Key, class Weight>
+std::vector<VertexId> BasicGraph<Key, Weight>::cachedBreadthFirstRoute(const VertexId& origin, const VertexId& destination, QueryContext& context) {
+    if(!queryCache.isEnabled()){
+        return findBreadthFirstRoute(origin, destination, context, metrics);
+    }
+
+    const std::vector<VertexId>* cached(queryCache.find(CachedQuery::BreadthFirstRoute, origin, destination));
+    if(cached != nullptr){
+        return *cached;
+    }
+
+    std::vector <VertexId> route(findBreadthFirstRoute(origin, destination, context, metrics));
+    std::vector <VertexId> dependencies;
+    for(std::vector<VertexId>::const_iterator it(context.pending.begin()); it != context.pending.end(); it++){
+        if(context.isVisited(*it)){
+            dependencies.push_back(*it);
+        }
+    }
+    queryCache.store(CachedQuery::BreadthFirstRoute, origin, destination, route, std::move(dependencies), vertexById.size());
+    return route;
+}
+
+/* Every thread takes the next few queries with its own context and
+metrics, so the Graph is only read. The metrics of the other threads are
+added to the Graph's once they have finished. */
+template <class Key, class Weight>
+std::vector<std::vector<VertexId>> BasicGraph<Key, Weight>::findRoutes(const std::vector<RouteQuery>& queries, const unsigned& numThreads, const bool& depthFirst) {
+    static constexpr std::size_t queriesPerTake = 16;
+
+    for(typename std::vector<RouteQuery>::const_iterator it(queries.begin()); it != queries.end(); it++){
+        if(it->origin >= vertexById.size() || it->destination >= vertexById.size()){
+            throw GraphException(std::string(depthFirst ? "depthFirstRoutes" : "breadthFirstRoutes") + ": at least one of the vertices doesn't exists.");
+        }
+    }
+
+    unsigned threads(numThreads != 0 ? numThreads : std::thread::hardware_concurrency());
+    std::size_t takes((queries.size() + queriesPerTake - 1) / queriesPerTake);
+    if(threads == 0){
+        threads = 1;
+    }
+    if(threads > takes){
+        threads = takes > 0 ? unsigned(takes) : 1;
+    }
+
+    std::vector <std::vector<VertexId>> routes;
+    routes.resize(queries.size());
+    std::vector <GraphMetrics> threadMetrics(threads - 1);
+    std::atomic <std::size_t> next(0);
+
+    auto task = [&](const unsigned& t) {
+        GraphMetrics& m(t == 0 ? metrics : threadMetrics[t - 1]);
+        QueryContext context;
+        for(std::size_t first(next.fetch_add(queriesPerTake)); first < queries.size(); first = next.fetch_add(queriesPerTake)){
+            std::size_t last(std::min(first + queriesPerTake, queries.size()));
+            for(std::size_t i(first); i < last; i++){
+                if(depthFirst){
+                    routes[i] = findDepthFirstRoute(queries[i].origin, queries[i].destination, context, m);
+                }
+                else{
+                    routes[i] = findBreadthFirstRoute(queries[i].origin, queries[i].destination, context, m);
+                }
+            }
+        }
+    };
+
+    std::vector <std::thread> workers;
+    for(unsigned t(1); t < threads; t++){
+        workers.emplace_back(task, t);
+    }
+    task(0);
+    for(typename std::vector<std::thread>::iterator it(workers.begin()); it != workers.end(); it++){
+        it->join();
+    }
+
+    for(typename std::vector<GraphMetrics>::const_iterator it(threadMetrics.begin()); it != threadMetrics.end(); it++){
+        metrics.merge(*it);
+    }
+    return routes;
+}
+
+template <class Key, class Weight>
+std::vector<VertexId> BasicGraph<Key, Weight>::breadthFirstRoute(const VertexId& origin, const VertexId& destination) {
+    if(queryCache.isEnabled()){
+        return breadthFirstRoute(origin, destination, queryCache.getContext());
+    }
+
+    QueryContext context;
+    return breadthFirstRoute(origin, destination, context);
+}
+
+template <class Key, class Weight>
+std::vector<VertexId> BasicGraph<Key, Weight>::depthFirstRoute(const VertexId& origin, const VertexId& destination) {
+    QueryContext context;
+    return depthFirstRoute(origin, destination, context);
+}
+
+template <class Key, class Weight>
+std::vector<VertexId> BasicGraph<Key, Weight>::breadthFirstRoute(const VertexId& origin, const VertexId& destination, QueryContext& context) {
+    if(origin >= vertexById.size() || destination >= vertexById.size()){
+        throw GraphException("breadthFirstRoute: at least one of the vertices doesn't exists.");
+    }
+    return cachedBreadthFirstRoute(origin, destination, context);
+}
+
+template <class Key, class Weight>
+std::vector<VertexId> BasicGraph<Key, Weight>::depthFirstRoute(const VertexId& origin, const VertexId& destination, QueryContext& context) {
+    if(origin >= vertexById.size() || destination >= vertexById.size()){
+        throw GraphException("depthFirstRoute: at least one of the vertices doesn't exists.");
+    }
+    return findDepthFirstRoute(origin, destination, context, metrics);
+}
+
+template <class Key, class Weight>
+std::vector<std::vector<VertexId>> BasicGraph<Key, Weight>::breadthFirstRoutes(const std::vector<RouteQuery>& queries, const unsigned& numThreads) {
+    return findRoutes(queries, numThreads, false);
+}
+
+template <class Key, class Weight>
+std::vector<std::vector<VertexId>> BasicGraph<Key, Weight>::depthFirstRoutes(const std::vector<RouteQuery>& queries, const unsigned& numThreads) {
+    return findRoutes(queries, numThreads, true);
+}
+
+/* Both searches grow a whole level at a time. The first level that
+reaches the other side holds a shortest route, the one through the
+meeting edge with the lowest total distance. Forward vertices keep their
+parent and backward vertices the next vertex towards the destination.
+A directed Graph without in-edges can't search backwards, so only the
+forward side grows and the destination is the whole backward side. */
+template <class Key, class Weight>
+std::vector<VertexId> BasicGraph<Key, Weight>::bidirectionalRoute(const VertexId& origin, const VertexId& destination) {
+    GraphMetrics::Timer timer(metrics, GraphOperation::Route);
+    if(origin >= vertexById.size() || destination >= vertexById.size()){
+        throw GraphException("bidirectionalRoute: at least one of the vertices doesn't exists.");
+    }
+    const bool searchBackward(!isDirected || trackInEdges);
+
+    std::vector <VertexId> route;
+    if(origin == destination){
+        route.push_back(origin);
+        return route;
+    }
+
+    enum : unsigned char { unseen, forward, backward };
+    std::vector <unsigned char> side(vertexById.size(), unseen);
+    std::vector <VertexId> parent(vertexById.size());
+    std::vector <std::uint32_t> distance(vertexById.size());
+    std::vector <VertexId> forwardFrontier(1, origin);
+    std::vector <VertexId> backwardFrontier(1, destination);
+    std::vector <VertexId> nextFrontier;
+    std::uint32_t bestDistance(std::numeric_limits<std::uint32_t>::max());
+    VertexId meetForward(origin), meetBackward(destination);
+
+    side[origin] = forward;
+    side[destination] = backward;
+    distance[origin] = 0;
+    distance[destination] = 0;
+    metrics.count(GraphCounter::Traversals);
+    metrics.count(GraphCounter::FrontierVertices, 2);
+
+    while(!forwardFrontier.empty() && !backwardFrontier.empty() && bestDistance == std::numeric_limits<std::uint32_t>::max()){
+        bool isForward(!searchBackward || forwardFrontier.size() <= backwardFrontier.size());
+        std::vector <VertexId>& frontier(isForward ? forwardFrontier : backwardFrontier);
+        unsigned char ownSide(isForward ? forward : backward);
+
+        nextFrontier.clear();
+        for(std::vector<VertexId>::const_iterator it(frontier.begin()); it != frontier.end(); it++){
+            VertexId current(*it);
+            auto reach = [&](const VertexId& neighbour) {
+                if(side[neighbour] == unseen){
+                    side[neighbour] = ownSide;
+                    parent[neighbour] = current;
+                    distance[neighbour] = distance[current] + 1;
+                    nextFrontier.push_back(neighbour);
+                }
+                else if(side[neighbour] != ownSide && distance[current] + 1 + distance[neighbour] < bestDistance){
+                    bestDistance = distance[current] + 1 + distance[neighbour];
+                    meetForward = isForward ? current : neighbour;
+                    meetBackward = isForward ? neighbour : current;
+                }
+            };
+
+            if(!isForward && isDirected){
+                std::vector <InEdge>& inEdges(vertexById[current]->getInEdges());
+                metrics.count(GraphCounter::EdgesScanned, inEdges.size());
+                for(typename std::vector<InEdge>::const_iterator inIt(inEdges.begin()); inIt != inEdges.end(); inIt++){
+                    reach(inIt->origin->getId());
+                }
+            }
+            else{
+                metrics.count(GraphCounter::EdgesScanned, vertexById[current]->getDegree());
+                for(Edge* aux(vertexById[current]->getFirstEdge()); aux != nullptr; aux = aux->getNextEdge()){
+                    reach(aux->getDestVertex()->getId());
+                }
+            }
+        }
+
+        frontier.swap(nextFrontier);
+        metrics.count(GraphCounter::FrontierVertices, frontier.size());
+        metrics.peak(GraphCounter::FrontierPeak, frontier.size());
+    }
+
+    if(bestDistance == std::numeric_limits<std::uint32_t>::max()){
+        return route;
+    }
+
+    route.reserve(bestDistance + 1);
+    for(VertexId v(meetForward); v != origin; v = parent[v]){
+        route.push_back(v);
+    }
+    route.push_back(origin);
+    std::reverse(route.begin(), route.end());
+    for(VertexId v(meetBackward); v != destination; v = parent[v]){
+        route.push_back(v);
+    }
+    route.push_back(destination);
+
+    return route;
+}
+
+template <class Key, class Weight>
+BasicGraph<Key, Weight> BasicGraph<Key, Weight>::primSpanningTree(const Key& origin){
+    Vertex* auxVer(findVertex(origin));
+    if(auxVer == nullptr){
+        throw GraphException("primSpanningTree: there is not such vertex.");
+    }
+
+    BasicGraph spanningTree;
+    std::vector <WeightedEdge> treeEdges(primSpanningTree(auxVer->getId()));
+
+    for(typename std::vector<WeightedEdge>::const_iterator it(treeEdges.begin()); it != treeEdges.end(); it++){
+        const Key& originLabel(vertexById[it->origin]->getLabel());
+        const Key& destLabel(vertexById[it->destination]->getLabel());
+
+        if(spanningTree.findVertex(originLabel) == nullptr){
+            spanningTree.insertVertex(originLabel);
+        }
+        if(spanningTree.findVertex(destLabel) == nullptr){
+            spanningTree.insertVertex(destLabel);
+        }
+        spanningTree.insertEdge(originLabel, destLabel, it->weight);
+    }
+    return spanningTree;
+}
+
+template <class Key, class Weight>
+std::vector<typename BasicGraph<Key, Weight>::WeightedEdge> BasicGraph<Key, Weight>::primSpanningTree(const VertexId& origin){
+    GraphMetrics::Timer timer(metrics, GraphOperation::SpanningTree);
+    if(origin >= vertexById.size()){
+        throw GraphException("primSpanningTree: there is not such vertex.");
+    }
+
+    std::vector <WeightedEdge> treeEdges;
+    std::vector <bool> visited(vertexById.size(), false);
+    std::tuple <VertexId, VertexId, Value> tempEdge;
+
+    class myGreater {
+    public:
+      bool operator () (const std::tuple <VertexId, VertexId, Value>& a, const std::tuple <VertexId, VertexId, Value>& b) const {
+        return std::get<2>(a) > std::get<2>(b);
+      }
+    };
+
+    std::priority_queue <std::tuple <VertexId, VertexId, Value>, std::vector <std::tuple <VertexId, VertexId, Value>>, myGreater> priQueue;
+
+    visited[origin] = true;
+    metrics.count(GraphCounter::Traversals);
+    metrics.count(GraphCounter::EdgesScanned, vertexById[origin]->getDegree());
+    metrics.count(GraphCounter::FrontierVertices, vertexById[origin]->getDegree());
+    Edge* auxEdge(vertexById[origin]->getFirstEdge());
+    while(auxEdge != nullptr){
+        priQueue.push(std::make_tuple(origin, auxEdge->getDestVertex()->getId(), isWeighted ? getValue(auxEdge) : Value(1)));
+        auxEdge = auxEdge->getNextEdge();
+    }
+
+    while(!priQueue.empty()){
+        tempEdge = priQueue.top();
+        priQueue.pop();
+
+        VertexId currentVertex(std::get<1>(tempEdge));
+        if(!visited[currentVertex]){
+            visited[currentVertex] = true;
+
+            auxEdge = vertexById[currentVertex]->getFirstEdge();
+            metrics.count(GraphCounter::EdgesScanned, vertexById[currentVertex]->getDegree());
+            metrics.count(GraphCounter::FrontierVertices, vertexById[currentVertex]->getDegree());
+            while(auxEdge != nullptr){
+                priQueue.push(std::make_tuple(currentVertex, auxEdge->getDestVertex()->getId(), isWeighted ? getValue(auxEdge) : Value(1)));
+                auxEdge = auxEdge->getNextEdge();
+            }
+            metrics.peak(GraphCounter::FrontierPeak, priQueue.size());
+
+            treeEdges.push_back(WeightedEdge{std::get<0>(tempEdge), currentVertex, std::get<2>(tempEdge)});
+        }
+    }
+    return treeEdges;
+}
+
+template <class Key, class Weight>
+typename BasicGraph<Key, Weight>::ShortestPath BasicGraph<Key, Weight>::dijkstraRoute(const Key& origin, const Key& destination) {
+    return dijkstraRoute(getVertexId(origin), getVertexId(destination));
+}
+
+template <class Key, class Weight>
+typename BasicGraph<Key, Weight>::ShortestPath BasicGraph<Key, Weight>::dijkstraRoute(const VertexId& origin, const VertexId& destination) {
+    return shortestRoute(origin, destination, nullptr);
+}
+
+template <class Key, class Weight>
+typename BasicGraph<Key, Weight>::ShortestPath BasicGraph<Key, Weight>::aStarRoute(const Key& origin, const Key& destination, const RouteHeuristic& heuristic) {
+    return aStarRoute(getVertexId(origin), getVertexId(destination), heuristic);
+}
+
+template <class Key, class Weight>
+typename BasicGraph<Key, Weight>::ShortestPath BasicGraph<Key, Weight>::aStarRoute(const VertexId& origin, const VertexId& destination, const RouteHeuristic& heuristic) {
+    return shortestRoute(origin, destination, &heuristic);
+}
+
+template <class Key, class Weight>
+std::vector<VertexId> BasicGraph<Key, Weight>::kHopNeighbourhood(const VertexId& origin, const unsigned& k) {
+    if(origin >= vertexById.size()){
+        throw GraphException("kHopNeighbourhood: there is not such vertex.");
+    }
+
+    std::size_t numExpanded(0);
+    if(!queryCache.isEnabled()){
+        QueryContext context;
+        return findKHopNeighbourhood(origin, k, context, numExpanded);
+    }
+
+    const std::vector<VertexId>* cached(queryCache.find(CachedQuery::KHopNeighbourhood, origin, k));
+    if(cached != nullptr){
+        return *cached;
+    }
+
+    std::vector <VertexId> result(findKHopNeighbourhood(origin, k, queryCache.getContext(), numExpanded));
+    queryCache.store(CachedQuery::KHopNeighbourhood, origin, k, result, std::vector<VertexId>(result.begin(), result.begin() + numExpanded), vertexById.size());
+    return result;
+}
+
+template <class Key, class Weight>
+void BasicGraph<Key, Weight>::setQueryCacheCapacity(const std::size_t& capacity) {
+    queryCache.setCapacity(capacity);
+}
+
+template <class Key, class Weight>
+std::size_t BasicGraph<Key, Weight>::getQueryCacheCapacity() {
+    return queryCache.getCapacity();
+}
+
+/* Vertices with the same number of edges are taken by id. */
+template <class Key, class Weight>
+void BasicGraph<Key, Weight>::buildHopIndex(const unsigned& k, const std::size_t& numVertices) {
+    queryCache.unpinAll();
+
+    std::vector <VertexId> hubs(vertexById.size());
+    for(VertexId v(0); v < hubs.size(); v++){
+        hubs[v] = v;
+    }
+    std::size_t numHubs(std::min(numVertices, hubs.size()));
+    std::partial_sort(hubs.begin(), hubs.begin() + numHubs, hubs.end(), [this](const VertexId& a, const VertexId& b) {
+        int degreeA(vertexById[a]->getDegree());
+        int degreeB(vertexById[b]->getDegree());
+        return degreeA > degreeB || (degreeA == degreeB && a < b);
+    });
+
+    for(std::size_t i(0); i < numHubs; i++){
+        std::size_t numExpanded(0);
+        std::vector <VertexId> result(findKHopNeighbourhood(hubs[i], k, queryCache.getContext(), numExpanded));
+        queryCache.pin(CachedQuery::KHopNeighbourhood, hubs[i], k, result, std::vector<VertexId>(result.begin(), result.begin() + numExpanded), vertexById.size());
+    }
+}
+
+/* Tarjan's algorithm with an explicit call stack: every frame keeps its
+vertex and the next edge to follow. A vertex that was reached but has no
+component yet is still on the component stack. Components come out
+sinks first, so they're numbered backwards to get a topological order. */
+template <class Key, class Weight>
+std::vector<VertexId> BasicGraph<Key, Weight>::stronglyConnectedComponents() {
+    GraphMetrics::Timer timer(metrics, GraphOperation::Traverse);
+    static constexpr VertexId unreached = std::numeric_limits<VertexId>::max();
+    const std::size_t numVertices(vertexById.size());
+
+    std::vector <VertexId> order(numVertices, unreached);
+    std::vector <VertexId> lowLink(numVertices);
+    std::vector <VertexId> component(numVertices, unreached);
+    std::vector <VertexId> myStack;
+    std::vector <std::pair<VertexId, Edge*>> callStack;
+    VertexId numReached(0);
+    VertexId numComponents(0);
+
+    metrics.count(GraphCounter::Traversals);
+    for(VertexId root(0); root < numVertices; root++){
+        if(order[root] != unreached){
+            continue;
+        }
+
+        order[root] = lowLink[root] = numReached++;
+        myStack.push_back(root);
+        callStack.push_back(std::make_pair(root, vertexById[root]->getFirstEdge()));
+        while(!callStack.empty()){
+            VertexId current(callStack.back().first);
+            Edge* aux(callStack.back().second);
+
+            if(aux != nullptr){
+                callStack.back().second = aux->getNextEdge();
+                metrics.count(GraphCounter::EdgesScanned);
+
+                VertexId dest(aux->getDestVertex()->getId());
+                if(order[dest] == unreached){
+                    order[dest] = lowLink[dest] = numReached++;
+                    myStack.push_back(dest);
+                    callStack.push_back(std::make_pair(dest, vertexById[dest]->getFirstEdge()));
+                    metrics.peak(GraphCounter::FrontierPeak, callStack.size());
+                }
+                else if(component[dest] == unreached){
+                    lowLink[current] = std::min(lowLink[current], order[dest]);
+                }
+                continue;
+            }
+
+            callStack.pop_back();
+            if(!callStack.empty()){
+                VertexId caller(callStack.back().first);
+                lowLink[caller] = std::min(lowLink[caller], lowLink[current]);
+            }
+
+            if(lowLink[current] == order[current]){
+                VertexId member;
+                do{
+                    member = myStack.back();
+                    myStack.pop_back();
+                    component[member] = numComponents;
+                }while(member != current);
+                numComponents++;
+            }
+        }
+    }
+    metrics.count(GraphCounter::FrontierVertices, numVertices);
+
+    for(std::vector<VertexId>::iterator it(component.begin()); it != component.end(); it++){
+        *it = numComponents - 1 - *it;
+    }
+    return component;
+}
+
+/* Vertices are grouped by component with a counting sort and the
+successors of a component are stamped with it, so repeated edges
+between two components are only kept once. */
+template <class Key, class Weight>
+Condensation BasicGraph<Key, Weight>::condensation() {
+    Condensation result;
+    result.component = stronglyConnectedComponents();
+
+    GraphMetrics::Timer timer(metrics, GraphOperation::Traverse);
+    const VertexId numComponents(result.component.empty() ? 0 : *std::max_element(result.component.begin(), result.component.end()) + 1);
+    result.numComponents = numComponents;
+
+    result.vertexOffsets.assign(std::size_t(numComponents) + 1, 0);
+    for(std::vector<VertexId>::const_iterator it(result.component.begin()); it != result.component.end(); it++){
+        result.vertexOffsets[*it + 1]++;
+    }
+    for(VertexId c(0); c < numComponents; c++){
+        result.vertexOffsets[c + 1] += result.vertexOffsets[c];
+    }
+
+    std::vector <std::size_t> next(result.vertexOffsets.begin(), result.vertexOffsets.end() - 1);
+    result.vertices.resize(result.component.size());
+    for(VertexId v(0); v < result.component.size(); v++){
+        result.vertices[next[result.component[v]]++] = v;
+    }
+
+    static constexpr VertexId unstamped = std::numeric_limits<VertexId>::max();
+    std::vector <VertexId> stamp(numComponents, unstamped);
+    result.edgeOffsets.reserve(std::size_t(numComponents) + 1);
+    result.edgeOffsets.push_back(0);
+    for(VertexId c(0); c < numComponents; c++){
+        for(std::size_t i(result.vertexOffsets[c]); i < result.vertexOffsets[c + 1]; i++){
+            Vertex* v(vertexById[result.vertices[i]]);
+            metrics.count(GraphCounter::EdgesScanned, v->getDegree());
+            for(Edge* aux(v->getFirstEdge()); aux != nullptr; aux = aux->getNextEdge()){
+                VertexId dest(result.component[aux->getDestVertex()->getId()]);
+                if(dest != c && stamp[dest] != c){
+                    stamp[dest] = c;
+                    result.successors.push_back(dest);
+                }
+            }
+        }
+        result.edgeOffsets.push_back(result.successors.size());
+    }
+
+    return result;
+}
+
+/* Kahn's algorithm: vertices are queued once all their predecessors are
+in the order, starting with the ones without predecessors by id. */
+template <class Key, class Weight>
+std::vector<VertexId> BasicGraph<Key, Weight>::topologicalOrder() {
+    GraphMetrics::Timer timer(metrics, GraphOperation::Traverse);
+    const std::size_t numVertices(vertexById.size());
+    std::vector <VertexId> inDegree(numVertices, 0);
+    std::vector <VertexId> order;
+    std::size_t front(0);
+
+    metrics.count(GraphCounter::Traversals);
+    for(typename std::vector<Vertex*>::const_iterator it(vertexById.begin()); it != vertexById.end(); it++){
+        metrics.count(GraphCounter::EdgesScanned, (*it)->getDegree());
+        for(Edge* aux((*it)->getFirstEdge()); aux != nullptr; aux = aux->getNextEdge()){
+            inDegree[aux->getDestVertex()->getId()]++;
+        }
+    }
+
+    order.reserve(numVertices);
+    for(VertexId v(0); v < numVertices; v++){
+        if(inDegree[v] == 0){
+            order.push_back(v);
+        }
+    }
+
+    while(front < order.size()){
+        Vertex* current(vertexById[order[front++]]);
+        metrics.count(GraphCounter::EdgesScanned, current->getDegree());
+        for(Edge* aux(current->getFirstEdge()); aux != nullptr; aux = aux->getNextEdge()){
+            VertexId dest(aux->getDestVertex()->getId());
+            if(--inDegree[dest] == 0){
+                order.push_back(dest);
+            }
+        }
+    }
+    metrics.count(GraphCounter::FrontierVertices, order.size());
+
+    if(order.size() != numVertices){
+        order.clear();
+    }
+    return order;
+}
+
+template <class Key, class Weight>
+bool BasicGraph<Key, Weight>::isAcyclic() {
+    return topologicalOrder().size() == vertexById.size();
+}
+
+/* Weights that fit in an int use the threaded Boruvka of CsrGraph. The
+others run Kruskal's algorithm over the same undirected edges, taking
+every edge of an unweighted Graph as 1 like the CsrGraph does. */
+template <class Key, class Weight>
+std::vector<typename BasicGraph<Key, Weight>::WeightedEdge> BasicGraph<Key, Weight>::minimumSpanningForest(const unsigned& numThreads) {
+    std::vector <WeightedEdge> forest;
+
+    if constexpr(WeightTraits<Weight>::fitsInInt){
+        std::vector <BasicWeightedEdge<int>> frozenForest(freeze().minimumSpanningForest(numThreads));
+        forest.reserve(frozenForest.size());
+        for(std::vector<BasicWeightedEdge<int>>::const_iterator it(frozenForest.begin()); it != frozenForest.end(); it++){
+            forest.push_back(WeightedEdge{it->origin, it->destination, Value(it->weight)});
+        }
+    }
+    else{
+        std::vector <WeightedEdge> edges;
+        for(typename std::vector<Vertex*>::const_iterator it(vertexById.begin()); it != vertexById.end(); it++){
+            for(Edge* aux((*it)->getFirstEdge()); aux != nullptr; aux = aux->getNextEdge()){
+                if(aux->getDestVertex() != *it){
+                    edges.push_back(WeightedEdge{(*it)->getId(), aux->getDestVertex()->getId(), isWeighted ? getValue(aux) : Value(1)});
+                }
+            }
+        }
+        std::stable_sort(edges.begin(), edges.end(), [](const WeightedEdge& a, const WeightedEdge& b) {
+            return a.weight < b.weight;
+        });
+
+        std::vector <VertexId> parent(vertexById.size());
+        for(VertexId v(0); v < parent.size(); v++){
+            parent[v] = v;
+        }
+        auto findRoot = [&parent](VertexId v) {
+            while(parent[v] != v){
+                parent[v] = parent[parent[v]];
+                v = parent[v];
+            }
+            return v;
+        };
+
+        for(typename std::vector<WeightedEdge>::const_iterator it(edges.begin()); it != edges.end(); it++){
+            VertexId rootA(findRoot(it->origin));
+            VertexId rootB(findRoot(it->destination));
+            if(rootA != rootB){
+                parent[rootA] = rootB;
+                forest.push_back(*it);
+            }
+        }
+    }
+
+    return forest;
+}
+
+template <class Key, class Weight>
+CsrGraph BasicGraph<Key, Weight>::freeze() {
+    if constexpr(WeightTraits<Weight>::isFreezable){
+        return CsrGraph(*this);
+    }
+    else{
+        throw GraphException("freeze: only Graphs with integral weights can be frozen.");
+    }
+}
+
+template <class Key, class Weight>
+GraphMemoryUsage BasicGraph<Key, Weight>::getMemoryUsage() {
+    GraphMemoryUsage usage;
+
+    usage.vertexBytes = vertexPool.getReservedBytes();
+    if constexpr(std::is_same<Key, std::string>::value){
+        for(typename std::vector<Vertex*>::const_iterator it(vertexById.begin()); it != vertexById.end(); it++){
+            const std::string& label((*it)->getLabel());
+            if(label.capacity() > std::string().capacity()){
+                usage.vertexBytes += label.capacity() + 1;
+            }
+        }
+    }
+    usage.edgeBytes = edgePool.getReservedBytes();
+    usage.indexBytes = vertexById.capacity() * sizeof(Vertex*)
+                     + vertexIndex.bucket_count() * sizeof(void*)
+                     + vertexIndex.size() * (sizeof(void*) + sizeof(size_t) + sizeof(std::pair<KeyView, Vertex*>));
+    usage.totalBytes = sizeof(BasicGraph) + usage.vertexBytes + usage.edgeBytes + usage.indexBytes;
+
+    std::size_t numVertices(vertexById.size());
+    std::size_t numEdges(edgePool.getLiveCount());
+    usage.bytesPerVertex = numVertices == 0 ? 0 : double(usage.vertexBytes + usage.indexBytes) / numVertices;
+    usage.bytesPerEdge = numEdges == 0 ? 0 : double(usage.edgeBytes) / numEdges;
+
+    return usage;
+}
+
+template <class Key, class Weight>
+GraphStats BasicGraph<Key, Weight>::stats() {
+    GraphStats result = GraphStats();
+
+    metrics.fill(result);
+    if(result.enabled){
+        result.vertexSlabs = vertexPool.getSlabCount();
+        result.edgeSlabs = edgePool.getSlabCount();
+    }
+
+    const QueryCache::Counters& cache(queryCache.getCounters());
+    result.cacheHits = cache.hits;
+    result.cacheMisses = cache.misses;
+    result.cacheInvalidations = cache.invalidations;
+    result.cacheEvictions = cache.evictions;
+    return result;
+}
+
+template <class Key, class Weight>
+void BasicGraph<Key, Weight>::resetStats() {
+    metrics.reset();
+    queryCache.resetCounters();
+}
+
+template <class Key, class Weight>
+void BasicGraph<Key, Weight>::deleteAll() {
+    /* Edges own no memory, so their slabs are given back without visiting
+    them. Vertices still need their destructor for the label. */
+    static_assert(std::is_trivially_destructible<Edge>::value, "deleteAll: edges must not own memory.");
+    for(typename std::vector<Vertex*>::const_iterator it(vertexById.begin()); it != vertexById.end(); it++){
+        (*it)->~Vertex();
+    }
+    vertexPool.releaseAll();
+    edgePool.releaseAll();
+
+    anchor = nullptr;
+    lastVertex = nullptr;
+    vertexIndex.clear();
+    vertexById.clear();
+    componentParent.clear();
+    connectivityDirty = false;
+    queryCache.clear();
+}
+
+/// --- CSR CONVERSION ---
+template <class Key, class Weight>
+CsrGraph::CsrGraph(BasicGraph<Key, Weight>& g) : isDirected(g.getIsDirected()), isWeighted(g.getIsWeighted()), mapping(nullptr), mappingSize(0) {
+    static_assert(WeightTraits<Weight>::isFreezable, "CsrGraph: weights must be integral.");
+
+    typedef typename BasicGraph<Key, Weight>::Vertex Vertex;
+    typedef typename BasicGraph<Key, Weight>::Edge Edge;
+
+    VertexId numVer(g.getNumVertices());
+    std::uint64_t numEdg(0);
+    for(VertexId i(0); i < numVer; i++){
+        numEdg += g.findVertex(i)->getDegree();
+    }
+
+    offsetStorage.reserve(numVer + 1);
+    destinationStorage.reserve(numEdg);
+    if(isWeighted){
+        weightStorage.reserve(numEdg);
+    }
+    labelOffsetStorage.reserve(numVer + 1);
+    offsetStorage.push_back(0);
+    labelOffsetStorage.push_back(0);
+
+    for(VertexId i(0); i < numVer; i++){
+        Vertex* auxVer(g.findVertex(i));
+
+        Edge* auxEdge(auxVer->getFirstEdge());
+        while(auxEdge != nullptr){
+            destinationStorage.push_back(auxEdge->getDestVertex()->getId());
+            if constexpr(WeightTraits<Weight>::hasWeights){
+                if(isWeighted){
+                    Weight weight(auxEdge->getWeight());
+                    if constexpr(!WeightTraits<Weight>::fitsInInt){
+                        bool tooLow(std::is_signed<Weight>::value && weight < Weight(std::numeric_limits<int>::min()));
+                        if(tooLow || weight > Weight(std::numeric_limits<int>::max())){
+                            throw GraphException("freeze: a weight doesn't fit in an int.");
+                        }
+                    }
+                    weightStorage.push_back(int(weight));
+                }
+            }
+            auxEdge = auxEdge->getNextEdge();
+        }
+        offsetStorage.push_back(destinationStorage.size());
+
+        if constexpr(std::is_same<Key, std::string>::value){
+            const std::string& label(auxVer->getLabel());
+            labelStorage.insert(labelStorage.end(), label.begin(), label.end());
+        }
+        else{
+            std::ostringstream label;
+            label << auxVer->getLabel();
+            const std::string& text(label.str());
+            labelStorage.insert(labelStorage.end(), text.begin(), text.end());
+        }
+        labelOffsetStorage.push_back(labelStorage.size());
+    }
+
+    pointToStorage();
+    buildLabelOrder();
+}
+
+#endif // GRAPH_TPP_INCLUDED
@@ -0,0 +1,3 @@
+#include "graphbuilder.h"
+
+template class BasicGraphBuilder<std::string, int>;
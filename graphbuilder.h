@@ -0,0 +1,157 @@
+#ifndef GRAPHBUILDER_H_INCLUDED
+#define GRAPHBUILDER_H_INCLUDED
+
+#include <string>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+#include "graph.h"
+
+/// -------- GRAPH BUILDER PROTOTYPE --------
+/* Loads vertices and edges straight into a Graph, skipping the checks
+insertVertex/insertEdge repeat on every call. Storage can be reserved up
+front and consecutive edges from the same origin reuse its lookup. When
+the origin changes its destinations are stamped once, so a repeated edge
+is found without scanning the edge list on every record. The result is
+the same as inserting everything one by one in the same order: a repeated
+vertex throws a GraphException, a repeated edge is ignored and an
+undirected Graph gets both directions of every edge. The Graph must not
+be changed by other means while the builder is in use. */
+template <class Key, class Weight>
+class BasicGraphBuilder{
+private:
+    typedef typename BasicGraph<Key, Weight>::Vertex Vertex;
+    typedef typename BasicGraph<Key, Weight>::Edge Edge;
+
+    BasicGraph<Key, Weight>& graph;
+    Vertex* lastOrigin;
+    Key lastOriginLabel;
+    Vertex* stampedOrigin;
+    std::vector<std::uint32_t> stamps;
+    std::uint32_t epoch;
+
+    void stampOrigin(Vertex*);
+    void appendEdge(Vertex*, Vertex*, const Weight&);
+
+public:
+    /* The Graph is emptied and keeps its type. */
+    explicit BasicGraphBuilder(BasicGraph<Key, Weight>&);
+
+    void reserve(const std::size_t&, const std::size_t&);
+
+    VertexId addVertex(const Key&);
+    void addEdge(const Key&, const Key&, const Weight&);
+    void addEdge(const VertexId&, const VertexId&, const Weight&);
+};
+
+typedef BasicGraphBuilder<std::string, int> GraphBuilder;
+
+/// --- PRIVATE METHODS ---
+/* Stamps with a new epoch the destinations the origin already has. */
+template <class Key, class Weight>
+void BasicGraphBuilder<Key, Weight>::stampOrigin(Vertex* origin) {
+    if(epoch == UINT32_MAX){
+        std::fill(stamps.begin(), stamps.end(), 0);
+        epoch = 0;
+    }
+    epoch++;
+
+    if(stamps.size() < graph.vertexById.size()){
+        stamps.resize(graph.vertexById.size(), 0);
+    }
+    for(Edge* aux(origin->getFirstEdge()); aux != nullptr; aux = aux->getNextEdge()){
+        stamps[aux->getDestVertex()->getId()] = epoch;
+    }
+    stampedOrigin = origin;
+}
+
+/* An undirected Graph always has both directions of an edge, so when the
+origin doesn't have it the destination doesn't have the reverse either. */
+template <class Key, class Weight>
+void BasicGraphBuilder<Key, Weight>::appendEdge(Vertex* origin, Vertex* destination, const Weight& weight) {
+    if(origin != stampedOrigin){
+        stampOrigin(origin);
+    }
+    if(destination->getId() >= stamps.size()){
+        stamps.resize(graph.vertexById.size(), 0);
+    }
+    if(stamps[destination->getId()] == epoch){
+        return;
+    }
+    stamps[destination->getId()] = epoch;
+
+    Edge* aux(graph.edgePool.create(weight));
+    aux->setDestVertex(destination);
+    graph.appendEdge(origin, aux);
+
+    if(!graph.isDirected && destination != origin){
+        Edge* aux2(graph.edgePool.create(weight));
+        aux2->setDestVertex(origin);
+        graph.appendEdge(destination, aux2);
+    }
+}
+
+/// --- PUBLIC METHODS ---
+template <class Key, class Weight>
+BasicGraphBuilder<Key, Weight>::BasicGraphBuilder(BasicGraph<Key, Weight>& g) : graph(g), lastOrigin(nullptr), lastOriginLabel(), stampedOrigin(nullptr), epoch(0) {
+    graph.deleteAll();
+}
+
+template <class Key, class Weight>
+void BasicGraphBuilder<Key, Weight>::reserve(const std::size_t& numVertices, const std::size_t& numEdges) {
+    graph.vertexIndex.reserve(numVertices);
+    graph.vertexById.reserve(numVertices);
+    graph.vertexPool.reserve(numVertices);
+    graph.edgePool.reserve(graph.isDirected ? numEdges : numEdges * 2);
+}
+
+template <class Key, class Weight>
+VertexId BasicGraphBuilder<Key, Weight>::addVertex(const Key& label) {
+    Vertex* aux(graph.vertexPool.create(label));
+    if(!graph.vertexIndex.emplace(aux->getLabel(), aux).second){
+        graph.vertexPool.destroy(aux);
+        throw GraphException("addVertex: that vertex already exists.");
+    }
+    graph.metrics.count(GraphCounter::VertexAllocations);
+
+    if(graph.isEmpty()){
+        graph.anchor = aux;
+    }
+    else{
+        graph.lastVertex->setNextVertex(aux);
+        aux->setPrevVertex(graph.lastVertex);
+    }
+    graph.lastVertex = aux;
+
+    aux->setId(graph.vertexById.size());
+    graph.vertexById.push_back(aux);
+
+    return aux->getId();
+}
+
+template <class Key, class Weight>
+void BasicGraphBuilder<Key, Weight>::addEdge(const Key& originLabel, const Key& destLabel, const Weight& weight) {
+    if(lastOrigin == nullptr || originLabel != lastOriginLabel){
+        lastOrigin = graph.findVertex(originLabel);
+        lastOriginLabel = originLabel;
+    }
+    Vertex* destination(graph.findVertex(destLabel));
+
+    if(lastOrigin == nullptr || destination == nullptr){
+        throw GraphException("addEdge: at least one vertex doesn't exists.");
+    }
+    appendEdge(lastOrigin, destination, weight);
+}
+
+template <class Key, class Weight>
+void BasicGraphBuilder<Key, Weight>::addEdge(const VertexId& origin, const VertexId& destination, const Weight& weight) {
+    if(origin >= graph.vertexById.size() || destination >= graph.vertexById.size()){
+        throw GraphException("addEdge: at least one vertex doesn't exists.");
+    }
+    appendEdge(graph.vertexById[origin], graph.vertexById[destination], weight);
+}
+
+extern template class BasicGraphBuilder<std::string, int>;
+
+#endif // GRAPHBUILDER_H_INCLUDED
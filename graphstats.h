@@ -0,0 +1,244 @@
+#ifndef GRAPHSTATS_H_INCLUDED
+#define GRAPHSTATS_H_INCLUDED
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+/// -------- OPERATION METRICS --------
+/* Counters and latency histograms kept by every Graph when the library is
+built with DINAMIC_GRAPH_METRICS defined (the same for every file, CMake
+does it with -DDINAMIC_GRAPH_METRICS=ON). Without it the Graph keeps no
+metrics, every hook compiles to nothing and stats() returns zeros. */
+#ifdef DINAMIC_GRAPH_METRICS
+constexpr bool graphMetricsEnabled = true;
+#else
+constexpr bool graphMetricsEnabled = false;
+#endif
+
+/* Operations with a latency histogram. Traverse and Route count the id
+versions, which the string ones call. */
+enum class GraphOperation {
+    InsertVertex, DeleteVertex, EditVertex,
+    InsertEdge, DeleteEdge, EditEdge, ExistsEdge, ApplyBatch,
+    Traverse, Route, ShortestRoute, SpanningTree,
+    SaveToFile, GetFromFile, Copy
+};
+
+constexpr std::size_t numGraphOperations = std::size_t(GraphOperation::Copy) + 1;
+
+inline const char* getOperationName(const GraphOperation& operation) {
+    static const char* const names[numGraphOperations] = {
+        "insertVertex", "deleteVertex", "editVertex",
+        "insertEdge", "deleteEdge", "editEdge", "existsEdge", "applyBatch",
+        "traverse", "route", "shortestRoute", "spanningTree",
+        "saveToFile", "getFromFile", "copy"
+    };
+    return names[std::size_t(operation)];
+}
+
+/* Calls of an operation by duration: bucket i has the calls that took
+[2^i, 2^(i+1)) nanoseconds, bucket 0 also the ones under a nanosecond. */
+struct LatencyHistogram {
+    static constexpr std::size_t numBuckets = 48;
+
+    std::uint64_t buckets[numBuckets];
+
+    std::uint64_t getCount() const {
+        std::uint64_t count(0);
+        for(std::size_t i(0); i < numBuckets; i++){
+            count += buckets[i];
+        }
+        return count;
+    }
+
+    /* Upper bound in nanoseconds of the bucket holding the given
+    percentile, so it overestimates by less than twice. 0 if empty. */
+    std::uint64_t getPercentile(const double& p) const {
+        std::uint64_t count(getCount());
+        if(count == 0){
+            return 0;
+        }
+
+        std::uint64_t rank(std::uint64_t(p / 100.0 * count));
+        std::uint64_t seen(0);
+        for(std::size_t i(0); i < numBuckets; i++){
+            seen += buckets[i];
+            if(seen > rank || seen == count){
+                return std::uint64_t(2) << i;
+            }
+        }
+        return std::uint64_t(2) << (numBuckets - 1);
+    }
+};
+
+/* Snapshot returned by Graph::stats(). Lookups and scans count the work of
+findVertex and of the edge lookups behind insertEdge, existsEdge... (an
+edge lookup is either answered by a hub hash or scans the edge list).
+Allocations count vertices and edges created by inserts, and the slabs are
+the ones the pools hold now. Traversals are the BFS/DFS visits and routes,
+shortest routes and Prim's trees: frontier counts every vertex they queue
+or stack and frontierPeak is the longest queue or stack any of them had.
+The query cache counters are kept even without metrics: invalidations are
+stale results found and evictions the ones pushed out by newer ones. */
+struct GraphStats {
+    bool enabled;
+    std::uint64_t vertexLookups;
+    std::uint64_t edgeLookups;
+    std::uint64_t hubLookups;
+    std::uint64_t edgesScanned;
+    std::uint64_t vertexAllocations;
+    std::uint64_t edgeAllocations;
+    std::uint64_t vertexSlabs;
+    std::uint64_t edgeSlabs;
+    std::uint64_t traversals;
+    std::uint64_t frontierVertices;
+    std::uint64_t frontierPeak;
+    std::uint64_t cacheHits;
+    std::uint64_t cacheMisses;
+    std::uint64_t cacheInvalidations;
+    std::uint64_t cacheEvictions;
+    LatencyHistogram latency[numGraphOperations];
+
+    const LatencyHistogram& getLatency(const GraphOperation& operation) const {
+        return latency[std::size_t(operation)];
+    }
+
+    /* Fraction of cache lookups that were hits, 0 without lookups. */
+    double getCacheHitRate() const {
+        std::uint64_t lookups(cacheHits + cacheMisses);
+        return lookups == 0 ? 0.0 : double(cacheHits) / lookups;
+    }
+};
+
+enum class GraphCounter {
+    VertexLookups, EdgeLookups, HubLookups, EdgesScanned,
+    VertexAllocations, EdgeAllocations, Traversals, FrontierVertices,
+    FrontierPeak
+};
+
+#ifdef DINAMIC_GRAPH_METRICS
+/* Only the thread working on the Graph updates the counters, so they are
+bumped with a relaxed load and store instead of a locked add, and stats()
+can still read them from any thread. Threads working for a batch keep
+their own metrics, merged into the Graph's when they are done. */
+class GraphMetrics{
+private:
+    static constexpr std::size_t numCounters = std::size_t(GraphCounter::FrontierPeak) + 1;
+
+    std::atomic<std::uint64_t> counters[numCounters];
+    std::atomic<std::uint64_t> buckets[numGraphOperations][LatencyHistogram::numBuckets];
+
+    static void bump(std::atomic<std::uint64_t>& value, const std::uint64_t& n) {
+        value.store(value.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+
+public:
+    /* Times the scope it's declared in. */
+    class Timer{
+    private:
+        GraphMetrics& metrics;
+        GraphOperation operation;
+        std::chrono::steady_clock::time_point start;
+
+    public:
+        Timer(GraphMetrics& m, const GraphOperation& op) : metrics(m), operation(op), start(std::chrono::steady_clock::now()) {}
+        Timer(const Timer&) = delete;
+        ~Timer() {
+            metrics.record(operation, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+        }
+
+        Timer& operator = (const Timer&) = delete;
+    };
+
+    GraphMetrics() {
+        reset();
+    }
+
+    void count(const GraphCounter& counter, const std::uint64_t& n = 1) {
+        bump(counters[std::size_t(counter)], n);
+    }
+
+    void peak(const GraphCounter& counter, const std::uint64_t& n) {
+        std::atomic<std::uint64_t>& value(counters[std::size_t(counter)]);
+        if(n > value.load(std::memory_order_relaxed)){
+            value.store(n, std::memory_order_relaxed);
+        }
+    }
+
+    void record(const GraphOperation& operation, const std::uint64_t& nanoseconds) {
+        std::size_t bucket(0);
+        while(bucket + 1 < LatencyHistogram::numBuckets && nanoseconds >> (bucket + 1) != 0){
+            bucket++;
+        }
+        bump(buckets[std::size_t(operation)][bucket], 1);
+    }
+
+    void merge(const GraphMetrics& other) {
+        for(std::size_t i(0); i < numCounters; i++){
+            std::uint64_t n(other.counters[i].load(std::memory_order_relaxed));
+            if(i == std::size_t(GraphCounter::FrontierPeak)){
+                peak(GraphCounter::FrontierPeak, n);
+            }
+            else{
+                bump(counters[i], n);
+            }
+        }
+        for(std::size_t i(0); i < numGraphOperations; i++){
+            for(std::size_t j(0); j < LatencyHistogram::numBuckets; j++){
+                bump(buckets[i][j], other.buckets[i][j].load(std::memory_order_relaxed));
+            }
+        }
+    }
+
+    void fill(GraphStats& stats) const {
+        stats.enabled = true;
+        stats.vertexLookups = counters[std::size_t(GraphCounter::VertexLookups)].load(std::memory_order_relaxed);
+        stats.edgeLookups = counters[std::size_t(GraphCounter::EdgeLookups)].load(std::memory_order_relaxed);
+        stats.hubLookups = counters[std::size_t(GraphCounter::HubLookups)].load(std::memory_order_relaxed);
+        stats.edgesScanned = counters[std::size_t(GraphCounter::EdgesScanned)].load(std::memory_order_relaxed);
+        stats.vertexAllocations = counters[std::size_t(GraphCounter::VertexAllocations)].load(std::memory_order_relaxed);
+        stats.edgeAllocations = counters[std::size_t(GraphCounter::EdgeAllocations)].load(std::memory_order_relaxed);
+        stats.traversals = counters[std::size_t(GraphCounter::Traversals)].load(std::memory_order_relaxed);
+        stats.frontierVertices = counters[std::size_t(GraphCounter::FrontierVertices)].load(std::memory_order_relaxed);
+        stats.frontierPeak = counters[std::size_t(GraphCounter::FrontierPeak)].load(std::memory_order_relaxed);
+        for(std::size_t i(0); i < numGraphOperations; i++){
+            for(std::size_t j(0); j < LatencyHistogram::numBuckets; j++){
+                stats.latency[i].buckets[j] = buckets[i][j].load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void reset() {
+        for(std::size_t i(0); i < numCounters; i++){
+            counters[i].store(0, std::memory_order_relaxed);
+        }
+        for(std::size_t i(0); i < numGraphOperations; i++){
+            for(std::size_t j(0); j < LatencyHistogram::numBuckets; j++){
+                buckets[i][j].store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+};
+#else
+/* Same interface doing nothing, so the hooks are optimized away. */
+class GraphMetrics{
+public:
+    class Timer{
+    public:
+        Timer(GraphMetrics&, const GraphOperation&) {}
+    };
+
+    void count(const GraphCounter&, const std::uint64_t& = 1) {}
+    void peak(const GraphCounter&, const std::uint64_t&) {}
+    void record(const GraphOperation&, const std::uint64_t&) {}
+    void merge(const GraphMetrics&) {}
+    void fill(GraphStats& stats) const {
+        stats.enabled = false;
+    }
+    void reset() {}
+};
+#endif
+
+#endif // GRAPHSTATS_H_INCLUDED
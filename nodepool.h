@@ -0,0 +1,231 @@
+#ifndef NODEPOOL_H_INCLUDED
+#define NODEPOOL_H_INCLUDED
+
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <vector>
+#include <algorithm>
+#include <functional>
+
+/// -------- NODE POOL --------
+/* Slab storage for the nodes of a Graph. Nodes are carved out of large
+blocks instead of one new per node, and destroyed nodes go to a free list
+so the next create() reuses their slot. */
+template <class T>
+class NodePool{
+private:
+    union Slot {
+        Slot* next;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    /* Slots past used have never been handed out. */
+    struct Slab {
+        Slot* first;
+        std::size_t size;
+        std::size_t used;
+    };
+
+    static constexpr std::size_t firstSlabSize = 64;
+    static constexpr std::size_t maxSlabSize = 65536;
+
+    std::vector<Slab> slabs;
+    Slot* freeList;
+    std::size_t liveCount;
+    std::size_t capacity;
+
+    void addSlab(const std::size_t& size) {
+        slabs.push_back(Slab{static_cast<Slot*>(::operator new(size * sizeof(Slot))), size, 0});
+        capacity += size;
+    }
+
+public:
+    /* Maps every slot of a pool to the slot at the same place in the pool
+    that cloned its layout. */
+    class Twins{
+        friend class NodePool;
+
+        struct Range {
+            const Slot* first;
+            std::size_t slab;
+            Slot* twin;
+        };
+        std::vector<Range> ranges;
+
+        void sortRanges() {
+            std::sort(ranges.begin(), ranges.end(), [](const Range& a, const Range& b) {
+                return std::less<const Slot*>()(a.first, b.first);
+            });
+        }
+
+        /* Last slab starting at or before the slot. */
+        const Range& findRange(const Slot* slot) const {
+            std::size_t low(0), high(ranges.size());
+            while(high - low > 1){
+                std::size_t mid((low + high) / 2);
+                if(std::less_equal<const Slot*>()(ranges[mid].first, slot)){
+                    low = mid;
+                }
+                else{
+                    high = mid;
+                }
+            }
+            return ranges[low];
+        }
+
+        Slot* twinSlot(const Slot* slot) const {
+            const Range& range(findRange(slot));
+            return range.twin + (slot - range.first);
+        }
+
+    public:
+        T* operator () (const T* node) const {
+            if(node == nullptr){
+                return nullptr;
+            }
+            return reinterpret_cast<T*>(twinSlot(reinterpret_cast<const Slot*>(node))->storage);
+        }
+    };
+
+    NodePool() : freeList(nullptr), liveCount(0), capacity(0) {}
+    NodePool(const NodePool&) = delete;
+    NodePool& operator = (const NodePool&) = delete;
+    ~NodePool() {
+        releaseAll();
+    }
+
+    template <class... Args>
+    T* create(Args&&... args) {
+        Slot* slot;
+        if(freeList != nullptr){
+            slot = freeList;
+            freeList = freeList->next;
+        }
+        else{
+            if(slabs.empty() || slabs.back().used == slabs.back().size){
+                std::size_t size(slabs.empty() ? firstSlabSize : slabs.back().size * 2);
+                if(size > maxSlabSize){
+                    size = maxSlabSize;
+                }
+                addSlab(size);
+            }
+            slot = slabs.back().first + slabs.back().used++;
+        }
+
+        T* node;
+        try{
+            node = new (slot->storage) T(std::forward<Args>(args)...);
+        }
+        catch(...){
+            slot->next = freeList;
+            freeList = slot;
+            throw;
+        }
+        liveCount++;
+        return node;
+    }
+
+    /* Makes room for at least n more nodes in a single slab. */
+    void reserve(const std::size_t& n) {
+        std::size_t available(slabs.empty() ? 0 : slabs.back().size - slabs.back().used);
+        if(n > available){
+            addSlab(n);
+        }
+    }
+
+    /* Nodes never move, so pointers to them stay valid in the other pool. */
+    void swap(NodePool& other) {
+        slabs.swap(other.slabs);
+        std::swap(freeList, other.freeList);
+        std::swap(liveCount, other.liveCount);
+        std::swap(capacity, other.capacity);
+    }
+
+    /* Empties the pool and gives it the same slabs and free slots as the
+    other one. Nothing is constructed: the caller builds a copy of every
+    node of the other pool in the slot the returned Twins maps it to. */
+    Twins cloneLayout(const NodePool& other) {
+        releaseAll();
+
+        Twins twins;
+        for(std::size_t i(0); i < other.slabs.size(); i++){
+            addSlab(other.slabs[i].size);
+            slabs.back().used = other.slabs[i].used;
+            twins.ranges.push_back(typename Twins::Range{other.slabs[i].first, i, slabs.back().first});
+        }
+        twins.sortRanges();
+
+        Slot** tail(&freeList);
+        for(const Slot* slot(other.freeList); slot != nullptr; slot = slot->next){
+            *tail = twins.twinSlot(slot);
+            tail = &(*tail)->next;
+        }
+        *tail = nullptr;
+        liveCount = other.liveCount;
+
+        return twins;
+    }
+
+    /* Calls visit with every live node, in the order of the slabs. */
+    template <class Visit>
+    void forEachNode(Visit visit) const {
+        Twins index;
+        std::vector<std::size_t> slabStart(slabs.size());
+        std::size_t total(0);
+        for(std::size_t i(0); i < slabs.size(); i++){
+            index.ranges.push_back(typename Twins::Range{slabs[i].first, i, nullptr});
+            slabStart[i] = total;
+            total += slabs[i].size;
+        }
+        index.sortRanges();
+
+        std::vector<bool> isFree(total, false);
+        for(const Slot* slot(freeList); slot != nullptr; slot = slot->next){
+            const typename Twins::Range& range(index.findRange(slot));
+            isFree[slabStart[range.slab] + (slot - range.first)] = true;
+        }
+
+        for(std::size_t i(0); i < slabs.size(); i++){
+            for(std::size_t j(0); j < slabs[i].used; j++){
+                if(!isFree[slabStart[i] + j]){
+                    visit(reinterpret_cast<T*>(slabs[i].first[j].storage));
+                }
+            }
+        }
+    }
+
+    void destroy(T* node) {
+        node->~T();
+        Slot* slot(reinterpret_cast<Slot*>(node));
+        slot->next = freeList;
+        freeList = slot;
+        liveCount--;
+    }
+
+    /* Gives every slab back at once. Destructors are not run, so nodes
+    that own memory have to be destroyed before. */
+    void releaseAll() {
+        for(std::size_t i(0); i < slabs.size(); i++){
+            ::operator delete(slabs[i].first);
+        }
+        slabs.clear();
+        freeList = nullptr;
+        liveCount = 0;
+        capacity = 0;
+    }
+
+    std::size_t getLiveCount() const {
+        return liveCount;
+    }
+
+    std::size_t getSlabCount() const {
+        return slabs.size();
+    }
+
+    std::size_t getReservedBytes() const {
+        return capacity * sizeof(Slot) + slabs.capacity() * sizeof(Slab);
+    }
+};
+
+#endif // NODEPOOL_H_INCLUDED
@@ -0,0 +1,215 @@
+#ifndef QUERYCACHE_H_INCLUDED
+#define QUERYCACHE_H_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "vertex.h"
+#include "querycontext.h"
+
+/// -------- QUERY CACHE --------
+enum class CachedQuery : std::uint8_t { KHopNeighbourhood, BreadthFirstRoute };
+
+/* Results of repeated queries of a Graph, kept in least recently used
+order up to a number of entries, plus a pinned set that is never evicted
+(the k-hop index). Every entry remembers the vertices whose edges it
+looked at. Changing the edges of a vertex stamps it with a new version,
+and an entry is only returned when none of its vertices has a version
+newer than the entry, so stale entries are dropped on lookup instead of
+searched for on every update. The Graph also keeps here the context its
+cache misses run on. */
+class QueryCache{
+public:
+    struct Counters {
+        std::uint64_t hits;
+        std::uint64_t misses;
+        std::uint64_t invalidations;
+        std::uint64_t evictions;
+    };
+
+private:
+    struct Key {
+        CachedQuery query;
+        VertexId vertex;
+        std::uint32_t k;
+
+        bool operator == (const Key& other) const {
+            return query == other.query && vertex == other.vertex && k == other.k;
+        }
+    };
+
+    struct KeyHash {
+        std::size_t operator()(const Key& key) const {
+            return std::hash<std::uint64_t>()((std::uint64_t(key.vertex) << 32 | key.k) * 2 + std::uint64_t(key.query));
+        }
+    };
+
+    struct Entry {
+        Key key;
+        std::vector<VertexId> result;
+        std::vector<VertexId> dependencies;
+        std::uint64_t version;
+    };
+
+    typedef std::list<Entry> EntryList;
+
+    std::size_t capacity;
+    EntryList entries;
+    std::unordered_map<Key, EntryList::iterator, KeyHash> entryIndex;
+    std::unordered_map<Key, Entry, KeyHash> pinned;
+    std::vector<std::uint64_t> versions;
+    std::uint64_t clock;
+    Counters counters;
+    QueryContext context;
+
+    bool isFresh(const Entry& entry) const {
+        for(std::vector<VertexId>::const_iterator it(entry.dependencies.begin()); it != entry.dependencies.end(); it++){
+            if(versions[*it] > entry.version){
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /* Vertices added since the last store start at version 0. */
+    Entry makeEntry(const Key& key, const std::vector<VertexId>& result, std::vector<VertexId>&& dependencies, const std::size_t& numVertices) {
+        if(versions.size() < numVertices){
+            versions.resize(numVertices, 0);
+        }
+        return Entry{key, result, std::move(dependencies), clock};
+    }
+
+public:
+    QueryCache() : capacity(0), clock(0), counters() {}
+
+    std::size_t getCapacity() const {
+        return capacity;
+    }
+
+    void setCapacity(const std::size_t& n) {
+        capacity = n;
+        while(entries.size() > capacity){
+            entryIndex.erase(entries.back().key);
+            entries.pop_back();
+            counters.evictions++;
+        }
+        if(!isEnabled()){
+            std::vector<std::uint64_t>().swap(versions);
+        }
+    }
+
+    bool isEnabled() const {
+        return capacity > 0 || !pinned.empty();
+    }
+
+    /* Called whenever the edges going out of a vertex change. */
+    void touch(const VertexId& v) {
+        if(v < versions.size()){
+            versions[v] = ++clock;
+        }
+    }
+
+    /* The cached result, or nullptr when it's missing or stale. */
+    const std::vector<VertexId>* find(const CachedQuery& query, const VertexId& vertex, const std::uint32_t& k) {
+        Key key{query, vertex, k};
+
+        std::unordered_map<Key, Entry, KeyHash>::const_iterator pin(pinned.find(key));
+        if(pin != pinned.end()){
+            if(isFresh(pin->second)){
+                counters.hits++;
+                return &pin->second.result;
+            }
+            counters.invalidations++;
+        }
+        else{
+            std::unordered_map<Key, EntryList::iterator, KeyHash>::iterator it(entryIndex.find(key));
+            if(it != entryIndex.end()){
+                if(isFresh(*it->second)){
+                    entries.splice(entries.begin(), entries, it->second);
+                    counters.hits++;
+                    return &it->second->result;
+                }
+                entries.erase(it->second);
+                entryIndex.erase(it);
+                counters.invalidations++;
+            }
+        }
+
+        counters.misses++;
+        return nullptr;
+    }
+
+    /* Keeps a result computed on a Graph with numVertices vertices. Pinned
+    keys are replaced in place, the others evict the least recently used
+    entry when the cache is full. */
+    void store(const CachedQuery& query, const VertexId& vertex, const std::uint32_t& k, const std::vector<VertexId>& result, std::vector<VertexId>&& dependencies, const std::size_t& numVertices) {
+        Key key{query, vertex, k};
+
+        std::unordered_map<Key, Entry, KeyHash>::iterator pin(pinned.find(key));
+        if(pin != pinned.end()){
+            pin->second = makeEntry(key, result, std::move(dependencies), numVertices);
+            return;
+        }
+        if(capacity == 0){
+            return;
+        }
+
+        if(entries.size() >= capacity){
+            entryIndex.erase(entries.back().key);
+            entries.pop_back();
+            counters.evictions++;
+        }
+        entries.push_front(makeEntry(key, result, std::move(dependencies), numVertices));
+        entryIndex[key] = entries.begin();
+    }
+
+    void pin(const CachedQuery& query, const VertexId& vertex, const std::uint32_t& k, const std::vector<VertexId>& result, std::vector<VertexId>&& dependencies, const std::size_t& numVertices) {
+        Key key{query, vertex, k};
+        pinned[key] = makeEntry(key, result, std::move(dependencies), numVertices);
+    }
+
+    void unpinAll() {
+        pinned.clear();
+        if(!isEnabled()){
+            std::vector<std::uint64_t>().swap(versions);
+        }
+    }
+
+    /* Drops every entry, pinned ones included, keeping the capacity. */
+    void clear() {
+        entries.clear();
+        entryIndex.clear();
+        pinned.clear();
+        versions.clear();
+        clock = 0;
+    }
+
+    const Counters& getCounters() const {
+        return counters;
+    }
+
+    void resetCounters() {
+        counters = Counters();
+    }
+
+    QueryContext& getContext() {
+        return context;
+    }
+
+    void swap(QueryCache& other) noexcept {
+        std::swap(capacity, other.capacity);
+        entries.swap(other.entries);
+        entryIndex.swap(other.entryIndex);
+        pinned.swap(other.pinned);
+        versions.swap(other.versions);
+        std::swap(clock, other.clock);
+        std::swap(counters, other.counters);
+        std::swap(context, other.context);
+    }
+};
+
+#endif // QUERYCACHE_H_INCLUDED
@@ -0,0 +1,71 @@
+#ifndef QUERYCONTEXT_H_INCLUDED
+#define QUERYCONTEXT_H_INCLUDED
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "vertex.h"
+
+template <class Key, class Weight> class BasicGraph;
+
+/// -------- QUERY CONTEXT --------
+/* Scratch buffers of the routes, kept from one query to the next so a
+route doesn't allocate or clear anything as big as the Graph. Every query
+takes a new epoch and a vertex is marked by writing the epoch in it, so
+the marks left by older queries are just lower numbers and are never
+cleared (except once every two billion queries, when the epoch wraps).
+A context can be used with any Graph, but by one thread at a time. */
+class QueryContext{
+private:
+    template <class Key, class Weight> friend class BasicGraph;
+
+    std::vector<std::uint32_t> marks;
+    std::uint32_t epoch;
+    std::vector<VertexId> parent;
+    std::vector<VertexId> pending;
+
+    /* Starts a query on a Graph with numVertices vertices. */
+    void begin(const std::size_t& numVertices) {
+        if(epoch >= UINT32_MAX - 3){
+            std::fill(marks.begin(), marks.end(), 0);
+            epoch = 0;
+        }
+        epoch += 2;
+
+        if(marks.size() < numVertices){
+            marks.resize(numVertices, 0);
+            parent.resize(numVertices);
+        }
+        pending.clear();
+    }
+
+    /* A vertex is reached when it is queued or stacked and visited once
+    it is expanded, which also leaves it reached. */
+    bool isReached(const VertexId& v) const {
+        return marks[v] >= epoch;
+    }
+
+    bool isVisited(const VertexId& v) const {
+        return marks[v] == epoch + 1;
+    }
+
+    void reach(const VertexId& v) {
+        marks[v] = epoch;
+    }
+
+    void visit(const VertexId& v) {
+        marks[v] = epoch + 1;
+    }
+
+public:
+    QueryContext() : epoch(0) {}
+};
+
+/* One query of a batch of routes. */
+struct RouteQuery {
+    VertexId origin;
+    VertexId destination;
+};
+
+#endif // QUERYCONTEXT_H_INCLUDED
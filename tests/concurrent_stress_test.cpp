@@ -0,0 +1,194 @@
+#include <atomic>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "concurrentgraph.h"
+
+using namespace std;
+
+/* Writers and readers hammering one ConcurrentGraph. Every writer step
+keeps the published Graph a spanning tree rooted at "0" (edges of weight
+1 to a lower label) plus extra edges of weight 2, so readers can check
+that each snapshot they take is whole: every vertex is reachable from
+"0", labels map back to their ids, the undirected edge count is even
+and vertices never disappear. A reader also keeps one snapshot across
+many publishes and checks it never changes. Build with
+-DDINAMIC_GRAPH_TSAN=ON to run it under ThreadSanitizer. */
+
+namespace {
+    const int numWriters = 2;
+    const int numReaders = 4;
+    const int stepsPerWriter = 1500;
+
+    Edge* findEdgeByWeight(Graph& g, const VertexId& v, const int& weight) {
+        for(Edge* aux(g.findVertex(v)->getFirstEdge()); aux != nullptr; aux = aux->getNextEdge()){
+            if(aux->getWeight() == weight && (weight != 1 || stoi(aux->getDestVertex()->getLabel()) < stoi(g.getVertexLabel(v)))){
+                return aux;
+            }
+        }
+        return nullptr;
+    }
+
+    void writerStep(Graph& g, mt19937& rng) {
+        const VertexId numVertices(g.getNumVertices());
+        unsigned op(rng() % 4);
+
+        if(op == 0 || numVertices < 8){
+            string label(to_string(numVertices));
+            g.insertVertex(label);
+            g.insertEdge(label, to_string(rng() % numVertices), 1);
+        }
+        else if(op == 1){
+            string a(to_string(rng() % numVertices));
+            string b(to_string(rng() % numVertices));
+            if(a != b && !g.existsEdge(a, b)){
+                g.insertEdge(a, b, 2);
+            }
+        }
+        else if(op == 2){
+            VertexId v(rng() % numVertices);
+            Edge* extra(findEdgeByWeight(g, v, 2));
+            if(extra != nullptr){
+                g.deleteEdge(g.getVertexLabel(v), extra->getDestVertex()->getLabel());
+            }
+        }
+        else{
+            /* Moves a vertex to another parent: the tree is broken between
+            the two calls, but never in a published version. */
+            int child(1 + rng() % (numVertices - 1));
+            VertexId v(g.getVertexId(to_string(child)));
+            Edge* treeEdge(findEdgeByWeight(g, v, 1));
+            string parent(to_string(rng() % child));
+            if(treeEdge != nullptr && !g.existsEdge(to_string(child), parent)){
+                g.deleteEdge(to_string(child), treeEdge->getDestVertex()->getLabel());
+                g.insertEdge(to_string(child), parent, 1);
+            }
+        }
+    }
+
+    /* Returns an empty string when the snapshot is consistent. */
+    string checkSnapshot(const CsrGraph& snapshot) {
+        const VertexId numVertices(snapshot.getNumVertices());
+        if(snapshot.getNumEdges() % 2 != 0){
+            return "odd number of edges in an undirected snapshot";
+        }
+
+        VertexId root(snapshot.getVertexId("0"));
+        if(snapshot.breadthFirstTraverse(root).size() != numVertices){
+            return "a vertex isn't reachable from the root";
+        }
+
+        for(VertexId v(0); v < numVertices; v++){
+            if(snapshot.getVertexId(snapshot.getVertexLabel(v)) != v){
+                return "label of vertex " + to_string(v) + " doesn't map back to it";
+            }
+        }
+
+        VertexId last(numVertices - 1);
+        if(snapshot.dijkstraRoute(root, last).vertices.empty()){
+            return "no shortest route to the last vertex";
+        }
+        return "";
+    }
+}
+
+int main() {
+    Graph base;
+    base.setIsDirected(false);
+    for(int i(0); i < 8; i++){
+        base.insertVertex(to_string(i));
+        if(i > 0){
+            base.insertEdge(to_string(i), to_string(i - 1), 1);
+        }
+    }
+
+    ConcurrentGraph shared(base);
+    atomic<int> writersLeft(numWriters);
+    atomic<int> readersReady(0);
+    atomic<long> reads(0);
+    atomic<bool> failed(false);
+    string failure;
+    mutex failureMutex;
+
+    auto fail = [&](const string& message) {
+        lock_guard<mutex> lock(failureMutex);
+        if(!failed.exchange(true)){
+            failure = message;
+        }
+    };
+
+    vector<thread> threads;
+    for(int w(0); w < numWriters; w++){
+        threads.emplace_back([&, w]() {
+            mt19937 rng(100 + w);
+            while(readersReady < numReaders){
+                this_thread::yield();
+            }
+
+            /* Writers never freeze the Graph, so they yield to let readers
+            publish between steps, and publish every so often themselves. */
+            for(int step(0); step < stepsPerWriter && !failed; step++){
+                shared.update([&rng](Graph& g) {
+                    writerStep(g, rng);
+                });
+                if(step % 100 == 99){
+                    shared.publish();
+                }
+                this_thread::yield();
+            }
+            writersLeft--;
+        });
+    }
+
+    for(int r(0); r < numReaders; r++){
+        threads.emplace_back([&, r]() {
+            shared_ptr<const CsrGraph> held(shared.snapshot());
+            const VertexId heldVertices(held->getNumVertices());
+            const uint64_t heldEdges(held->getNumEdges());
+            const size_t heldReached(held->breadthFirstTraverse(0).size());
+            VertexId lastVertices(0);
+            readersReady++;
+
+            while(writersLeft > 0 && !failed){
+                shared_ptr<const CsrGraph> snapshot(shared.snapshot());
+                if(snapshot->getNumVertices() < lastVertices){
+                    fail("reader " + to_string(r) + " saw the vertex count go back");
+                }
+                lastVertices = snapshot->getNumVertices();
+
+                string problem(checkSnapshot(*snapshot));
+                if(!problem.empty()){
+                    fail("reader " + to_string(r) + ": " + problem);
+                }
+                reads++;
+            }
+
+            if(held->getNumVertices() != heldVertices || held->getNumEdges() != heldEdges
+                || held->breadthFirstTraverse(0).size() != heldReached || !checkSnapshot(*held).empty()){
+                fail("reader " + to_string(r) + " saw its held snapshot change");
+            }
+        });
+    }
+
+    for(vector<thread>::iterator it(threads.begin()); it != threads.end(); it++){
+        it->join();
+    }
+
+    if(!failed){
+        string problem(checkSnapshot(*shared.snapshot()));
+        if(!problem.empty()){
+            fail("final snapshot: " + problem);
+        }
+    }
+
+    if(failed){
+        cout << "concurrent stress: FAILED, " << failure << endl;
+        return 1;
+    }
+    cout << "concurrent stress: ok, " << reads << " snapshots read, " << shared.snapshot()->getNumVertices() << " vertices" << endl;
+    return 0;
+}
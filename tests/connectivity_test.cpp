@@ -0,0 +1,143 @@
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "graph.h"
+
+using namespace std;
+
+/* Checks connected() and componentId() against a breadth-first search
+after every step of random streams of inserts, deletions, batches and
+copies, on directed and undirected Graphs, with the index tracked and
+rebuilt on demand. Exits with 1 on the first mismatch. */
+
+namespace {
+    /* Component of every vertex following edges both ways, named by the
+    lowest id reached. */
+    vector<VertexId> breadthFirstComponents(Graph& g) {
+        const VertexId numVertices(g.getNumVertices());
+        vector<vector<VertexId>> neighbours(numVertices);
+        for(VertexId v(0); v < numVertices; v++){
+            for(Edge* aux(g.findVertex(v)->getFirstEdge()); aux != nullptr; aux = aux->getNextEdge()){
+                VertexId dest(aux->getDestVertex()->getId());
+                neighbours[v].push_back(dest);
+                neighbours[dest].push_back(v);
+            }
+        }
+
+        const VertexId unreached(numVertices);
+        vector<VertexId> component(numVertices, unreached);
+        for(VertexId root(0); root < numVertices; root++){
+            if(component[root] != unreached){
+                continue;
+            }
+            vector<VertexId> myQueue(1, root);
+            component[root] = root;
+            for(size_t front(0); front < myQueue.size(); front++){
+                for(VertexId dest : neighbours[myQueue[front]]){
+                    if(component[dest] == unreached){
+                        component[dest] = root;
+                        myQueue.push_back(dest);
+                    }
+                }
+            }
+        }
+        return component;
+    }
+
+    bool check(Graph& g, mt19937& rng, const string& where) {
+        vector<VertexId> expected(breadthFirstComponents(g));
+        const VertexId numVertices(g.getNumVertices());
+
+        for(VertexId a(0); a < numVertices; a++){
+            VertexId b(rng() % numVertices);
+            bool same(expected[a] == expected[b]);
+            if(g.connected(a, b) != same || g.connected(g.getVertexLabel(a), g.getVertexLabel(b)) != same){
+                cerr << where << ": connected(" << a << ", " << b << ") should be " << same << endl;
+                return false;
+            }
+            if((g.componentId(a) == g.componentId(b)) != same){
+                cerr << where << ": componentId of " << a << " and " << b << " should " << (same ? "" : "not ") << "match" << endl;
+                return false;
+            }
+            if(expected[g.componentId(a)] != expected[a]){
+                cerr << where << ": componentId(" << a << ") is outside its component" << endl;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool runStream(const bool& isDirected, const bool& tracked, const unsigned& seed, const int& steps) {
+        mt19937 rng(seed);
+        Graph g;
+        int nextLabel(0);
+
+        g.setIsDirected(isDirected);
+        g.setTrackConnectivity(tracked);
+        for(int i(0); i < 30; i++){
+            g.insertVertex(to_string(nextLabel++));
+        }
+
+        for(int step(0); step < steps; step++){
+            const VertexId numVertices(g.getNumVertices());
+            string origin(g.getVertexLabel(rng() % numVertices));
+            string destination(g.getVertexLabel(rng() % numVertices));
+            unsigned op(rng() % 20);
+
+            if(op < 8){
+                if(!g.existsEdge(origin, destination)){
+                    g.insertEdge(origin, destination, 1);
+                }
+            }
+            else if(op < 12){
+                Vertex* v(g.findVertex(origin));
+                if(v->getFirstEdge() != nullptr){
+                    g.deleteEdge(origin, v->getFirstEdge()->getDestVertex()->getLabel());
+                }
+            }
+            else if(op < 14){
+                g.insertVertex(to_string(nextLabel++));
+            }
+            else if(op < 16){
+                if(numVertices > 10){
+                    g.deleteVertex(origin);
+                }
+            }
+            else if(op < 18){
+                vector<Mutation> batch;
+                for(int i(0); i < 6; i++){
+                    MutationType type(rng() % 2 == 0 ? MutationType::InsertEdge : MutationType::DeleteEdge);
+                    batch.push_back(Mutation{type, g.getVertexLabel(rng() % numVertices), g.getVertexLabel(rng() % numVertices), 1});
+                }
+                g.applyBatch(batch);
+            }
+            else if(op < 19){
+                Graph copy(g);
+                g = copy;
+            }
+            else{
+                Graph moved(std::move(g));
+                g = std::move(moved);
+            }
+
+            string where((isDirected ? "directed" : "undirected") + string(tracked ? " tracked" : " untracked")
+                + " seed " + to_string(seed) + " step " + to_string(step));
+            if(!check(g, rng, where)){
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+int main() {
+    bool ok(true);
+    for(unsigned seed(1); seed <= 3 && ok; seed++){
+        ok = runStream(false, true, seed, 1500) && runStream(true, true, seed, 1500)
+            && runStream(false, false, seed, 300) && runStream(true, false, seed, 300);
+    }
+
+    cout << (ok ? "connectivity: ok" : "connectivity: FAILED") << endl;
+    return ok ? 0 : 1;
+}
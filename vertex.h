@@ -2,26 +2,75 @@
 #define VERTEX_H_INCLUDED
 
 #include <string>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
 #include "edge.h"
 
-class Edge;
-class Vertex {
+/* Dense integer handle given to every vertex when it is inserted. */
+typedef std::uint32_t VertexId;
+
+template <class Key, class Weight> class BasicEdge;
+
+template <class Key, class Weight>
+class BasicVertex {
+  public:
+    /* An edge pointing to this vertex and the vertex it comes from. */
+    struct InEdge {
+        BasicVertex* origin;
+        BasicEdge<Key, Weight>* edge;
+    };
+
   private:
-    std::string label;
-    Vertex* nextVertex;
+    typedef BasicEdge<Key, Weight> Edge;
+
+    Key label;
+    VertexId id;
+    int degree;
+    BasicVertex* nextVertex;
+    BasicVertex* prevVertex;
     Edge* firstEdge;
+    Edge* lastEdge;
+
+    /* Destination -> edge before the one to it (nullptr for the first
+    edge), only built for vertices with a high degree. */
+    std::unordered_map<BasicVertex*, Edge*>* neighbourIndex;
+
+    /* Edges pointing to this vertex, only filled when the Graph tracks them. */
+    std::vector<InEdge> inEdges;
 
   public:
-    Vertex();
-    Vertex(const std::string&);
+    BasicVertex() : label(), id(0), degree(0), nextVertex(nullptr), prevVertex(nullptr), firstEdge(nullptr), lastEdge(nullptr), neighbourIndex(nullptr) {}
+    BasicVertex(const Key& l) : BasicVertex() {
+        label = l;
+    }
+    BasicVertex(const BasicVertex&) = delete;
+    ~BasicVertex() {
+        delete neighbourIndex;
+    }
 
-    std::string getLabel();
-    Vertex* getNextVertex();
-    Edge* getFirstEdge();
+    BasicVertex& operator = (const BasicVertex&) = delete;
 
-    void setLabel(const std::string&);
-    void setNextVertex(Vertex*);
-    void setFirstEdge(Edge*);
+    const Key& getLabel() { return label; }
+    VertexId getId() { return id; }
+    BasicVertex* getNextVertex() { return nextVertex; }
+    BasicVertex* getPrevVertex() { return prevVertex; }
+    Edge* getFirstEdge() { return firstEdge; }
+    Edge* getLastEdge() { return lastEdge; }
+    int getDegree() { return degree; }
+    std::unordered_map<BasicVertex*, Edge*>* getNeighbourIndex() { return neighbourIndex; }
+    std::vector<InEdge>& getInEdges() { return inEdges; }
+
+    void setLabel(const Key& l) { label = l; }
+    void setId(const VertexId& i) { id = i; }
+    void setNextVertex(BasicVertex* v) { nextVertex = v; }
+    void setPrevVertex(BasicVertex* v) { prevVertex = v; }
+    void setFirstEdge(Edge* e) { firstEdge = e; }
+    void setLastEdge(Edge* e) { lastEdge = e; }
+    void setDegree(const int& d) { degree = d; }
+    void setNeighbourIndex(std::unordered_map<BasicVertex*, Edge*>* index) { neighbourIndex = index; }
 };
 
+typedef BasicVertex<std::string, int> Vertex;
+
 #endif // VERTEX_H_INCLUDED